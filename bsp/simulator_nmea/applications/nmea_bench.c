@@ -0,0 +1,607 @@
+#include <rtthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include <nmea_parse.h>
+
+#define BENCH_DEF_LOOPS         (10000)
+
+static const char *bench_corpus[] =
+{
+        "$GPRMC,173843,A,3349.896,N,11808.521,W,000.0,360.0,230108,013.4,E*69\r\n",
+        "$GPGGA,111609.14,5001.27,N,3613.06,E,3,08,0.0,10.2,M,0.0,M,0.0,0000*70\r\n",
+        "$GPGSV,2,1,08,01,05,005,80,02,05,050,80,03,05,095,80,04,05,140,80*7f\r\n",
+        "$GPGSV,2,2,08,05,05,185,80,06,05,230,80,07,05,275,80,08,05,320,80*71\r\n",
+        "$GPGSA,A,3,01,02,03,04,05,06,07,08,00,00,00,00,0.0,0.0,0.0*3a\r\n",
+        "$GPRMC,111609.14,A,5001.27,N,3613.06,E,11.2,0.0,261206,0.0,E*50\r\n",
+        "$GPVTG,217.5,T,208.8,M,000.00,N,000.01,K*4C\r\n",
+        "$GPRMC,031024.000,A,3115.6422,N,12127.5490,E,0.58,98.86,180918,,,A*5A\r\n"
+};
+
+#define BENCH_CORPUS_SIZE       (sizeof(bench_corpus) / sizeof(bench_corpus[0]))
+
+static int bench_type[BENCH_CORPUS_SIZE];
+static int bench_len[BENCH_CORPUS_SIZE];
+
+static int bench_loops(int argc, char **argv)
+{
+    int loops = (argc > 1) ? atoi(argv[1]) : BENCH_DEF_LOOPS;
+
+    return (loops > 0) ? loops : BENCH_DEF_LOOPS;
+}
+
+static void bench_prepare(void)
+{
+    int it;
+
+    for (it = 0; it < BENCH_CORPUS_SIZE; ++it)
+    {
+        bench_len[it] = (int)rt_strlen(bench_corpus[it]);
+        bench_type[it] = nmea_pack_type(bench_corpus[it] + 1, bench_len[it] - 1);
+    }
+}
+
+static void bench_report(const char *name, int count, rt_tick_t ticks)
+{
+    if (!ticks)
+        ticks = 1;
+
+    rt_kprintf("%-12s: %d sentences in %d ms, %d sentences/s\n", name, count,
+        (int)(ticks * 1000 / RT_TICK_PER_SECOND),
+        (int)((double)count * RT_TICK_PER_SECOND / ticks));
+}
+
+/**
+ * Compare compiled sentence decoders with nmea_scanf() on the same corpus
+ */
+void nmea_bench_decode(int argc, char **argv)
+{
+    int loops = bench_loops(argc, argv);
+    int it, loop, nok = 0;
+    nmea_pack_t pack_a;
+#ifndef NMEA_USING_FIXED_POINT
+    nmea_pack_t pack_b;
+    int ndiff = 0;
+#endif
+    rt_tick_t tick;
+
+    bench_prepare();
+
+#ifndef NMEA_USING_FIXED_POINT
+    for (it = 0; it < BENCH_CORPUS_SIZE; ++it)
+    {
+        rt_memset(&pack_a, 0, sizeof(pack_a));
+        rt_memset(&pack_b, 0, sizeof(pack_b));
+        nmea_pack_decode(bench_type[it], bench_corpus[it], bench_len[it], &pack_a);
+        nmea_pack_scanf(bench_type[it], bench_corpus[it], bench_len[it], &pack_b);
+        if (rt_memcmp(&pack_a, &pack_b, sizeof(pack_a)))
+            ndiff++;
+    }
+    rt_kprintf("decoders differ on %d of %d sentences\n", ndiff, BENCH_CORPUS_SIZE);
+
+    tick = rt_tick_get();
+    for (loop = 0; loop < loops; ++loop)
+        for (it = 0; it < BENCH_CORPUS_SIZE; ++it)
+            nok += nmea_pack_scanf(bench_type[it], bench_corpus[it], bench_len[it], &pack_b);
+    bench_report("nmea_scanf", nok, rt_tick_get() - tick);
+#endif
+
+    nok = 0;
+    tick = rt_tick_get();
+    for (loop = 0; loop < loops; ++loop)
+        for (it = 0; it < BENCH_CORPUS_SIZE; ++it)
+            nok += nmea_pack_decode(bench_type[it], bench_corpus[it], bench_len[it], &pack_a);
+    bench_report("compiled", nok, rt_tick_get() - tick);
+}
+MSH_CMD_EXPORT(nmea_bench_decode, benchmark nmea sentence decoders: [loops]);
+
+static const char *bench_num_corpus[] =
+{
+    "3349.896", "11808.521", "000.0", "360.0", "013.4", "111609.14", "10.2",
+    "217.5", "000.01", "3115.6422", "12127.5490", "0.58", "98.86"
+};
+
+#define BENCH_NUM_SIZE          (sizeof(bench_num_corpus) / sizeof(bench_num_corpus[0]))
+
+/**
+ * Compare nmea_atof() with copy + strtod() on typical field values
+ */
+void nmea_bench_num(int argc, char **argv)
+{
+    int loops = bench_loops(argc, argv);
+    int it, loop, len[BENCH_NUM_SIZE];
+    char tmp[NMEA_CONVSTR_BUF];
+    volatile double sum = 0;
+    rt_tick_t tick;
+
+    for (it = 0; it < BENCH_NUM_SIZE; ++it)
+        len[it] = (int)rt_strlen(bench_num_corpus[it]);
+
+    tick = rt_tick_get();
+    for (loop = 0; loop < loops; ++loop)
+        for (it = 0; it < BENCH_NUM_SIZE; ++it)
+        {
+            rt_memcpy(tmp, bench_num_corpus[it], len[it]);
+            tmp[len[it]] = '\0';
+            sum += strtod(tmp, RT_NULL);
+        }
+    bench_report("strtod", loops * BENCH_NUM_SIZE, rt_tick_get() - tick);
+
+    tick = rt_tick_get();
+    for (loop = 0; loop < loops; ++loop)
+        for (it = 0; it < BENCH_NUM_SIZE; ++it)
+            sum += nmea_atof(bench_num_corpus[it], len[it]);
+    bench_report("nmea_atof", loops * BENCH_NUM_SIZE, rt_tick_get() - tick);
+}
+MSH_CMD_EXPORT(nmea_bench_num, benchmark nmea number parsing: [loops]);
+
+/**
+ * Compare struct tm + mktime() with integer nmea_time_unix_ms()
+ */
+void nmea_bench_time(int argc, char **argv)
+{
+    int loops = bench_loops(argc, argv);
+    nmea_time_t utc = { 118, 8, 18, 3, 10, 24, 0 };
+    volatile rt_int64_t sum = 0;
+    struct tm dt;
+    rt_tick_t tick;
+    int loop;
+
+    tick = rt_tick_get();
+    for (loop = 0; loop < loops; ++loop)
+    {
+        dt.tm_year = utc.year;
+        dt.tm_mon = utc.mon;
+        dt.tm_mday = utc.day;
+        dt.tm_hour = utc.hour;
+        dt.tm_min = utc.min;
+        dt.tm_sec = utc.sec + (loop & 31);
+        dt.tm_isdst = 0;
+        sum += (rt_int64_t)mktime(&dt) * 1000 + utc.hsec * 10;
+    }
+    bench_report("mktime", loops, rt_tick_get() - tick);
+
+    tick = rt_tick_get();
+    for (loop = 0; loop < loops; ++loop)
+    {
+        utc.sec = 24 + (loop & 31);
+        sum += nmea_time_unix_ms(&utc);
+    }
+    bench_report("unix_ms", loops, rt_tick_get() - tick);
+}
+MSH_CMD_EXPORT(nmea_bench_time, benchmark nmea utc time conversion: [loops]);
+
+/**
+ * Compare nmea_find_tail() with char by char reference
+ */
+void nmea_bench_tail(int argc, char **argv)
+{
+    int loops = bench_loops(argc, argv);
+    int it, loop, crc, nok = 0;
+    rt_tick_t tick;
+
+    bench_prepare();
+
+    tick = rt_tick_get();
+    for (loop = 0; loop < loops; ++loop)
+        for (it = 0; it < BENCH_CORPUS_SIZE; ++it)
+            nok += (nmea_find_tail_ref(bench_corpus[it], bench_len[it], &crc) > 0);
+    bench_report("reference", nok, rt_tick_get() - tick);
+
+    nok = 0;
+    tick = rt_tick_get();
+    for (loop = 0; loop < loops; ++loop)
+        for (it = 0; it < BENCH_CORPUS_SIZE; ++it)
+            nok += (nmea_find_tail(bench_corpus[it], bench_len[it], &crc) > 0);
+    bench_report("find_tail", nok, rt_tick_get() - tick);
+}
+MSH_CMD_EXPORT(nmea_bench_tail, benchmark nmea sentence tail search: [loops]);
+
+/**
+ * Compare nmea_parse() of all sentences with RMC and GGA only, dropped
+ * after checksum or at address field
+ */
+void nmea_bench_filter(int argc, char **argv)
+{
+    static const char *name[] = { "all", "filter", "filter fast" };
+    int loops = bench_loops(argc, argv);
+    int it, loop, mode, npack;
+    nmea_info_t info = { 0 };
+    nmea_parser_t parser;
+    rt_tick_t tick;
+
+    bench_prepare();
+
+    for (mode = 0; mode < 3; ++mode)
+    {
+        nmea_parser_init(&parser);
+        if (mode)
+            nmea_parser_set_filter(&parser, GPGGA | GPRMC, mode - 1);
+
+        npack = 0;
+        tick = rt_tick_get();
+        for (loop = 0; loop < loops; ++loop)
+            for (it = 0; it < BENCH_CORPUS_SIZE; ++it)
+                npack += nmea_parse(&parser, bench_corpus[it], bench_len[it], &info);
+        bench_report(name[mode], loops * BENCH_CORPUS_SIZE, rt_tick_get() - tick);
+        rt_kprintf("packets: %d\n", npack);
+
+        nmea_parser_destroy(&parser);
+    }
+}
+MSH_CMD_EXPORT(nmea_bench_filter, benchmark nmea parse with sentence filter: [loops]);
+
+/**
+ * Compare checksum and full decode of GGA with view reading time and position only
+ */
+void nmea_bench_view(int argc, char **argv)
+{
+    int loops = bench_loops(argc, argv);
+    int loop, len, crc, nok = 0;
+    const char *gga = bench_corpus[1];
+    nmea_sentence_view_t view;
+    volatile nmea_coord_t sum = 0;
+    nmea_time_t utc;
+    nmea_pack_t pack;
+    rt_tick_t tick;
+
+    len = (int)rt_strlen(gga);
+
+    tick = rt_tick_get();
+    for (loop = 0; loop < loops; ++loop)
+    {
+        if (nmea_find_tail(gga, len, &crc) > 0 && crc >= 0 && nmea_pack_decode(GPGGA, gga, len, &pack))
+        {
+            sum += pack.gga.lat + pack.gga.lon;
+            nok++;
+        }
+    }
+    bench_report("decode", nok, rt_tick_get() - tick);
+
+    nok = 0;
+    tick = rt_tick_get();
+    for (loop = 0; loop < loops; ++loop)
+    {
+        if (nmea_view_init(&view, gga, len) && 0 == nmea_view_get_time(&view, 1, &utc))
+        {
+            sum += nmea_view_get_latlon(&view, 2) + nmea_view_get_latlon(&view, 4);
+            nok++;
+        }
+    }
+    bench_report("view", nok, rt_tick_get() - tick);
+}
+MSH_CMD_EXPORT(nmea_bench_view, benchmark nmea lazy field access: [loops]);
+
+#define BENCH_BATCH_RECORDS     (64)
+
+/**
+ * Build log of corpus repeated loops times
+ * @return Log buffer or RT_NULL, size is returned by log_sz
+ */
+static char *bench_log(int loops, int *log_sz)
+{
+    int it, loop, len = 0;
+    char *log;
+
+    for (it = 0; it < BENCH_CORPUS_SIZE; ++it)
+        len += bench_len[it];
+
+    log = (char *)rt_malloc(len * loops);
+    if (!log)
+        return RT_NULL;
+
+    for (len = 0, loop = 0; loop < loops; ++loop)
+    {
+        for (it = 0; it < BENCH_CORPUS_SIZE; ++it)
+        {
+            rt_memcpy(log + len, bench_corpus[it], bench_len[it]);
+            len += bench_len[it];
+        }
+    }
+
+    *log_sz = len;
+
+    return log;
+}
+
+/**
+ * Compare nmea_parse() by chunks of parse buffer with nmea_parse_batch() in place
+ */
+void nmea_bench_batch(int argc, char **argv)
+{
+    int loops = bench_loops(argc, argv);
+    int pos, nread, log_sz, nrec = 0, npack = 0;
+    rt_uint32_t offset[BENCH_BATCH_RECORDS];
+    nmea_coord_t lat[BENCH_BATCH_RECORDS], lon[BENCH_BATCH_RECORDS];
+    nmea_info_t info = { 0 };
+    nmea_parser_t parser;
+    nmea_batch_t batch;
+    rt_tick_t tick;
+    char *log;
+
+    bench_prepare();
+    log = bench_log(loops, &log_sz);
+    if (!log)
+        return;
+
+    nmea_parser_init(&parser);
+    tick = rt_tick_get();
+    for (pos = 0; pos < log_sz; pos += nread)
+    {
+        nread = (log_sz - pos < NMEA_DEF_PARSEBUFF / 2) ? log_sz - pos : NMEA_DEF_PARSEBUFF / 2;
+        npack += nmea_parse(&parser, log + pos, nread, &info);
+    }
+    bench_report("nmea_parse", npack, rt_tick_get() - tick);
+    nmea_parser_destroy(&parser);
+
+    nmea_batch_init(&batch, BENCH_BATCH_RECORDS, GPNON);
+    batch.offset = offset;
+    batch.lat = lat;
+    batch.lon = lon;
+    tick = rt_tick_get();
+    for (pos = 0; pos < log_sz; pos += nread)
+    {
+        nread = nmea_parse_batch(&batch, log + pos, log_sz - pos);
+        if (pos + nread >= log_sz)
+            nmea_batch_flush(&batch);
+        nrec += batch.count;
+        nmea_batch_reset(&batch);
+        if (!nread)
+            break;
+    }
+    bench_report("batch", loops * BENCH_CORPUS_SIZE, rt_tick_get() - tick);
+    rt_kprintf("batch records: %d\n", nrec);
+
+    rt_free(log);
+}
+MSH_CMD_EXPORT(nmea_bench_batch, benchmark nmea batch parse: [loops]);
+
+/**
+ * Throughput of nmea_parse_parallel() versus number of threads,
+ * output arrays hold records of the whole log
+ */
+void nmea_bench_parallel(int argc, char **argv)
+{
+    int loops = bench_loops(argc, argv);
+    int nread, log_sz, nthreads;
+    nmea_batch_t batch;
+    rt_tick_t tick;
+    char name[16];
+    char *log;
+
+    bench_prepare();
+    log = bench_log(loops, &log_sz);
+    if (!log)
+        return;
+
+    nmea_batch_init(&batch, loops * BENCH_CORPUS_SIZE, GPNON);
+    batch.offset = (rt_uint32_t *)rt_malloc(batch.capacity * sizeof(rt_uint32_t));
+    batch.lat = (nmea_coord_t *)rt_malloc(batch.capacity * sizeof(nmea_coord_t));
+    batch.lon = (nmea_coord_t *)rt_malloc(batch.capacity * sizeof(nmea_coord_t));
+
+    for (nthreads = 1; batch.offset && batch.lat && batch.lon && nthreads <= NMEA_PARALLEL_MAX_THREADS; nthreads *= 2)
+    {
+        batch.base = 0;
+        nmea_batch_reset(&batch);
+        tick = rt_tick_get();
+        nread = nmea_parse_parallel(&batch, log, log_sz, nthreads);
+        rt_snprintf(name, sizeof(name), "threads %d", nthreads);
+        bench_report(name, loops * BENCH_CORPUS_SIZE, rt_tick_get() - tick);
+        rt_kprintf("records: %d, bytes: %d of %d\n", batch.count, nread, log_sz);
+    }
+
+    rt_free(batch.offset);
+    rt_free(batch.lat);
+    rt_free(batch.lon);
+    rt_free(log);
+}
+MSH_CMD_EXPORT(nmea_bench_parallel, benchmark nmea parallel batch parse: [loops]);
+
+/**
+ * Compare fix of NMEA cycle (GGA, GSA, RMC, VTG) with fix of one UBX NAV-PVT frame
+ */
+void nmea_bench_ubx(int argc, char **argv)
+{
+    static const int cycle[] = { 1, 4, 5, 6 };
+    int loops = bench_loops(argc, argv);
+    rt_uint8_t frame[NMEA_UBX_NAV_PVT_SIZE + NMEA_UBX_FRAME_OVERHEAD] = { 0xB5, 0x62, 0x01, 0x07, NMEA_UBX_NAV_PVT_SIZE, 0 };
+    int it, loop, nbyte = 0;
+    nmea_info_t info = { 0 };
+    nmea_parser_t parser;
+    rt_uint16_t ck;
+    rt_tick_t tick;
+
+    bench_prepare();
+
+    /* 3D fix of 12 satellites */
+    frame[6 + 11] = 0x07;
+    frame[6 + 20] = 3;
+    frame[6 + 21] = 0x01;
+    frame[6 + 23] = 12;
+    ck = nmea_ubx_checksum(frame + 2, NMEA_UBX_NAV_PVT_SIZE + 4);
+    frame[sizeof(frame) - 2] = (rt_uint8_t)ck;
+    frame[sizeof(frame) - 1] = (rt_uint8_t)(ck >> 8);
+
+    nmea_parser_init(&parser);
+    tick = rt_tick_get();
+    for (loop = 0; loop < loops; ++loop)
+        for (it = 0; it < sizeof(cycle) / sizeof(cycle[0]); ++it)
+            nmea_parse_stream(&parser, bench_corpus[cycle[it]], bench_len[cycle[it]], &info);
+    bench_report("nmea cycle", loops, rt_tick_get() - tick);
+    nmea_parser_destroy(&parser);
+
+    for (it = 0; it < sizeof(cycle) / sizeof(cycle[0]); ++it)
+        nbyte += bench_len[cycle[it]];
+    rt_kprintf("bytes: %d by fix\n", nbyte);
+
+    nmea_parser_init(&parser);
+    nmea_parser_set_ubx_handler(&parser, nmea_ubx_info_handler, &info);
+    tick = rt_tick_get();
+    for (loop = 0; loop < loops; ++loop)
+        nmea_parse_stream(&parser, (const char *)frame, sizeof(frame), &info);
+    bench_report("ubx nav-pvt", loops, rt_tick_get() - tick);
+    rt_kprintf("bytes: %d by fix, frames: %d\n", (int)sizeof(frame), (int)parser.ubx_count);
+    nmea_parser_destroy(&parser);
+}
+MSH_CMD_EXPORT(nmea_bench_ubx, benchmark nmea cycle against ubx nav-pvt: [loops]);
+
+static void bench_rtcm_sink(const rt_uint8_t *frame, int frame_sz, void *user_data)
+{
+    *(int *)user_data += frame_sz;
+}
+
+void nmea_bench_rtcm(int argc, char **argv)
+{
+    static rt_uint8_t stream[4 * NMEA_RTCM_FRAME_SIZE(300)];
+    int loops = bench_loops(argc, argv);
+    int it, loop, pos, len = 0, chunk, nbyte = 0;
+    nmea_info_t info = { 0 };
+    nmea_parser_t parser;
+    rt_uint32_t crc;
+    rt_tick_t tick;
+
+    bench_prepare();
+
+    /* MSM7 sized frames of 4 constellations */
+    for (it = 0; it < 4; ++it)
+    {
+        stream[len] = NMEA_RTCM_PREAMBLE;
+        stream[len + 1] = (rt_uint8_t)(300 >> 8);
+        stream[len + 2] = (rt_uint8_t)300;
+        for (pos = 0; pos < 300; ++pos)
+            stream[len + 3 + pos] = (rt_uint8_t)(pos * 13 + it);
+        crc = nmea_crc24q(0, stream + len, 303);
+        stream[len + 303] = (rt_uint8_t)(crc >> 16);
+        stream[len + 304] = (rt_uint8_t)(crc >> 8);
+        stream[len + 305] = (rt_uint8_t)crc;
+        len += NMEA_RTCM_FRAME_SIZE(300);
+    }
+
+    tick = rt_tick_get();
+    for (loop = 0; loop < loops; ++loop)
+        crc = nmea_crc24q(0, stream, len);
+    bench_report("crc24q", loops, rt_tick_get() - tick);
+    rt_kprintf("bytes: %d, crc: 0x%06X\n", len, (unsigned)crc);
+
+    /* whole epoch in one read is forwarded without copy, 64-byte reads go through cache */
+    for (chunk = len; chunk >= 64; chunk = (chunk == len) ? 64 : 0)
+    {
+        nmea_parser_init(&parser);
+        nmea_parser_set_rtcm_sink(&parser, bench_rtcm_sink, &nbyte);
+        tick = rt_tick_get();
+        for (loop = 0; loop < loops; ++loop)
+            for (pos = 0; pos < len; pos += chunk)
+                nmea_parse_stream(&parser, (const char *)stream + pos, (len - pos < chunk) ? len - pos : chunk, &info);
+        bench_report((chunk == len) ? "rtcm epoch" : "rtcm 64-byte reads", loops, rt_tick_get() - tick);
+        rt_kprintf("frames: %d, direct: %d\n", (int)parser.rtcm_count, (int)parser.rtcm_direct);
+        nmea_parser_destroy(&parser);
+    }
+}
+MSH_CMD_EXPORT(nmea_bench_rtcm, benchmark rtcm3 pass-through: [loops]);
+
+/**
+ * \brief Sentence by vsnprintf() with checksum computed in second pass, as nmealib generates it
+ */
+static int bench_printf(char *buff, int buff_sz, const char *format, ...)
+{
+    int it, len, crc = 0;
+    va_list args;
+
+    va_start(args, format);
+    len = vsnprintf(buff, buff_sz, format, args);
+    va_end(args);
+
+    if (len < 0 || len >= buff_sz)
+        return 0;
+
+    for (it = 1; it < len; ++it)
+        crc ^= (unsigned char)buff[it];
+    len += snprintf(buff + len, buff_sz - len, "*%02X\r\n", crc);
+
+    return (len < buff_sz) ? len : 0;
+}
+
+/**
+ * \brief Fix cycle GGA, GSA, GSV and RMC of nmealib format strings
+ */
+static int bench_generate_printf(char *buff, int buff_sz, const nmea_info_t *info)
+{
+    const nmea_time_t *utc = &info->utc;
+    double lat = nmea_coord2degree(info->lat), lon = nmea_coord2degree(info->lon);
+    const nmea_satellite_t *sat;
+    int it, ipack, npack, len = 0;
+
+    /* degrees to NDEG of nmealib */
+    lat = (lat < 0) ? -lat : lat;
+    lon = (lon < 0) ? -lon : lon;
+    lat = (int)lat * 100 + (lat - (int)lat) * 60;
+    lon = (int)lon * 100 + (lon - (int)lon) * 60;
+
+    len += bench_printf(buff + len, buff_sz - len,
+        "$GNGGA,%02d%02d%02d.%02d,%07.4f,%c,%07.4f,%c,%1d,%02d,%03.1f,%03.1f,%c,%03.1f,%c,,",
+        utc->hour, utc->min, utc->sec, utc->hsec, lat, (info->lat < 0) ? 'S' : 'N', lon, (info->lon < 0) ? 'W' : 'E',
+        info->sig, info->satinfo.inuse, nmea_centi2double(info->HDOP), nmea_dist2meter(info->elv), 'M', 0.0, 'M');
+
+    len += bench_printf(buff + len, buff_sz - len,
+        "$GNGSA,%c,%1d,%02d,%02d,%02d,%02d,%02d,%02d,%02d,%02d,%02d,%02d,%02d,%02d,%03.1f,%03.1f,%03.1f",
+        'A', info->fix,
+        info->satinfo.sat[0].id, info->satinfo.sat[1].id, info->satinfo.sat[2].id, info->satinfo.sat[3].id,
+        info->satinfo.sat[4].id, info->satinfo.sat[5].id, info->satinfo.sat[6].id, info->satinfo.sat[7].id,
+        info->satinfo.sat[8].id, info->satinfo.sat[9].id, info->satinfo.sat[10].id, info->satinfo.sat[11].id,
+        nmea_centi2double(info->PDOP), nmea_centi2double(info->HDOP), nmea_centi2double(info->VDOP));
+
+    npack = (info->satinfo.inview + NMEA_SATINPACK - 1) / NMEA_SATINPACK;
+    for (ipack = 0; ipack < npack; ++ipack)
+    {
+        sat = &info->satinfo.sat[ipack * NMEA_SATINPACK];
+        len += bench_printf(buff + len, buff_sz - len,
+            "$GNGSV,%1d,%1d,%02d,%02d,%02d,%03d,%02d,%02d,%02d,%03d,%02d,%02d,%02d,%03d,%02d,%02d,%02d,%03d,%02d",
+            npack, ipack + 1, info->satinfo.inview,
+            sat[0].id, sat[0].elv, sat[0].azimuth, sat[0].sig, sat[1].id, sat[1].elv, sat[1].azimuth, sat[1].sig,
+            sat[2].id, sat[2].elv, sat[2].azimuth, sat[2].sig, sat[3].id, sat[3].elv, sat[3].azimuth, sat[3].sig);
+    }
+
+    it = (info->sig > 0);
+    len += bench_printf(buff + len, buff_sz - len,
+        "$GNRMC,%02d%02d%02d.%02d,%c,%07.4f,%c,%07.4f,%c,%03.1f,%03.1f,%02d%02d%02d,,,%c",
+        utc->hour, utc->min, utc->sec, utc->hsec, it ? 'A' : 'V', lat, (info->lat < 0) ? 'S' : 'N',
+        lon, (info->lon < 0) ? 'W' : 'E', nmea_centi2double(info->speed) / NMEA_TUD_KNOTS,
+        nmea_centi2double(info->direction), utc->day, utc->mon + 1, utc->year % 100, it ? 'A' : 'N');
+
+    return len;
+}
+
+/**
+ * Compare integer sentence generator with vsnprintf() of nmealib on the same fix
+ */
+void nmea_bench_gen(int argc, char **argv)
+{
+    static const int cycle[] = { 1, 2, 3, 4, 5 };
+    static char out[1024];
+    int loops = bench_loops(argc, argv);
+    int it, loop, len = 0;
+    nmea_info_t info = { 0 };
+    nmea_parser_t parser;
+    rt_tick_t tick;
+
+    bench_prepare();
+
+    nmea_parser_init(&parser);
+    for (it = 0; it < sizeof(cycle) / sizeof(cycle[0]); ++it)
+        nmea_parse(&parser, bench_corpus[cycle[it]], bench_len[cycle[it]], &info);
+    nmea_parser_destroy(&parser);
+
+    tick = rt_tick_get();
+    for (loop = 0; loop < loops; ++loop)
+        len = bench_generate_printf(out, sizeof(out), &info);
+    bench_report("vsnprintf", loops * 5, rt_tick_get() - tick);
+    rt_kprintf("bytes: %d by cycle\n", len);
+
+    tick = rt_tick_get();
+    for (loop = 0; loop < loops; ++loop)
+        len = nmea_generate(out, sizeof(out), &info, NMEA_TALKER_GN, GPGGA | GPGSA | GPGSV | GPRMC);
+    bench_report("nmea_generate", loops * 5, rt_tick_get() - tick);
+    rt_kprintf("bytes: %d by cycle\n", len);
+}
+MSH_CMD_EXPORT(nmea_bench_gen, benchmark nmea sentence generator against vsnprintf: [loops]);
@@ -1,5 +1,6 @@
 #include <rtthread.h>
 #include <stdio.h>
+#include <stdlib.h>
 
 #define USING_NMEA_LIB
 
@@ -55,21 +56,1126 @@ void nmea_parse_test_01(void)
     {
         nmea_parse(&parser, buff[it], (int)rt_strlen(buff[it]), &info);
 
-        dbg_printf("RMC : Lat: %lf, Lon: %lf, Sig: %d, Fix: %d\n", info.lat,
-            info.lon, info.sig, info.fix);
+        dbg_printf("RMC : Lat: %lf, Lon: %lf, Sig: %d, Fix: %d\n",
+            nmea_coord2degree(info.lat), nmea_coord2degree(info.lon), info.sig, info.fix);
     }
 #endif
     int len = rt_strlen(buff2);
     dbg_printf("buffer len = %d\n", len);
     nmea_parse(&parser, buff2, (int)rt_strlen(buff2), &info);
 
-    dbg_printf("RMC : Lat: %lf, Lon: %lf, Sig: %d, Fix: %d\n", info.lat,
-        info.lon, info.sig, info.fix);
+    dbg_printf("RMC : Lat: %lf, Lon: %lf, Sig: %d, Fix: %d\n",
+        nmea_coord2degree(info.lat), nmea_coord2degree(info.lon), info.sig, info.fix);
 
     nmea_parser_destroy(&parser);
 }
 
 MSH_CMD_EXPORT(nmea_parse_test_01, nmea_parse_test_01);
 
+static void nmea_stream_handler(int ptype, void *pack, void *user_data)
+{
+    int *count = (int *)user_data;
+
+    count[0]++;
+    if (GPRMC == ptype)
+        dbg_printf("stream RMC : status: %c, speed: %lf\n", ((nmea_rmc_t *)pack)->status,
+            nmea_centi2double(((nmea_rmc_t *)pack)->speed));
+}
+
+void nmea_parse_test_02(void)
+{
+    int it, npack = 0, count = 0;
+    nmea_info_t info = { 0 };
+    nmea_parser_t parser;
+
+    nmea_parser_init(&parser);
+    nmea_parser_set_handler(&parser, nmea_stream_handler, &count);
+
+    for (it = 0; it < 8; ++it)
+        npack += nmea_parse_stream(&parser, buff[it], (int)rt_strlen(buff[it]), &info);
+
+    dbg_printf("stream : packets: %d, handler calls: %d\n", npack, count);
+    dbg_printf("stream : Lat: %lf, Lon: %lf, Sig: %d, Fix: %d\n",
+        nmea_coord2degree(info.lat), nmea_coord2degree(info.lon), info.sig, info.fix);
+
+    nmea_parser_destroy(&parser);
+}
+
+MSH_CMD_EXPORT(nmea_parse_test_02, nmea parse stream mode test);
+
+#define FEED_TEST_PASSES        (5000)
+
+static volatile int feed_writer_done;
+static volatile int feed_writer_nsen;
+
+static void nmea_feed_writer(void *parameter)
+{
+    nmea_parser_t *parser = (nmea_parser_t *)parameter;
+    int it, pass, pos, len, nsen = 0;
+
+    /* chunks of 5 bytes like from DMA, cache wraps many times */
+    for (pass = 0; pass < FEED_TEST_PASSES; ++pass)
+    {
+        for (it = 0; it < 8; ++it)
+        {
+            len = (int)rt_strlen(buff[it]);
+            for (pos = 0; pos < len; pos += 5)
+                nsen += nmea_parser_feed(parser, buff[it] + pos, (len - pos < 5) ? len - pos : 5);
+        }
+    }
+
+    feed_writer_nsen = nsen;
+    feed_writer_done = 1;
+}
+
+void nmea_parse_test_03(void)
+{
+    int it, pos, nsen = 0, npack = 0;
+    nmea_info_t info = { 0 };
+    nmea_parser_t parser;
+    rt_thread_t tid;
+
+    nmea_parser_init(&parser);
+
+    /* bytes come one by one, like from UART receive interrupt */
+    for (it = 0; it < 8; ++it)
+    {
+        for (pos = 0; buff[it][pos]; ++pos)
+            nsen += nmea_parser_feed(&parser, &buff[it][pos], 1);
+    }
+    npack = nmea_parser_poll(&parser, &info);
+
+    dbg_printf("feed : sentences: %d, packets: %d, crc errors: %d\n",
+        nsen, npack, (int)parser.crc_error);
+    dbg_printf("feed : Lat: %lf, Lon: %lf, Sig: %d, Fix: %d\n",
+        nmea_coord2degree(info.lat), nmea_coord2degree(info.lon), info.sig, info.fix);
+
+    nmea_parser_destroy(&parser);
+
+    /* feeding and polling run at the same time */
+    nmea_parser_init(&parser);
+    feed_writer_done = 0;
+    npack = 0;
+
+    tid = rt_thread_create("nmeafeed", nmea_feed_writer, &parser, 2048,
+        rt_thread_self()->current_priority, 1);
+    if (!tid)
+        return;
+    rt_thread_startup(tid);
+
+    while (!feed_writer_done)
+        npack += nmea_parser_poll(&parser, &info);
+    npack += nmea_parser_poll(&parser, &info);
+
+    dbg_printf("feed : concurrent sentences: %d, packets: %d, crc errors: %d (expected packets equal to sentences, 0)\n",
+        (int)feed_writer_nsen, npack, (int)parser.crc_error);
+
+    nmea_parser_destroy(&parser);
+}
+
+MSH_CMD_EXPORT(nmea_parse_test_03, nmea parse byte feed test);
+
+static const char *num_corpus[] =
+{
+    "0", "-0", "0.0", "-0.0", ".5", "-.5", "1.", "+12.5", "000.00", "000.01",
+    "10.2", "0.58", "98.86", "217.5", "3349.896", "11808.521", "3115.6422",
+    "12127.5490", "0.1", "0.3", "2.675", "123456789012345", "9007199254740993",
+    "1e3", "1.5E-2", "12345678901234567890123", "0.000000000000000000000001",
+    "", "-", "12a", "5001.27,N"
+};
+
+/**
+ * \brief Compare number parsers with strtod(), result must be bit-exact
+ */
+static int nmea_num_check(const char *str, int str_sz)
+{
+    char tmp[NMEA_CONVSTR_BUF];
+    double a, b;
+
+    rt_memcpy(tmp, str, str_sz);
+    tmp[str_sz] = '\0';
+    a = nmea_atof(str, str_sz);
+    b = strtod(tmp, RT_NULL);
+
+    if (rt_memcmp(&a, &b, sizeof(double)))
+    {
+        dbg_printf("num  : '%s' parsed as %.17g, strtod %.17g\n", tmp, a, b);
+        return 1;
+    }
+
+    return 0;
+}
+
+void nmea_parse_test_04(void)
+{
+    int it, pos, len, nerr = 0;
+    char str[32];
+    rt_int32_t fix = 0;
+
+    for (it = 0; it < sizeof(num_corpus) / sizeof(num_corpus[0]); ++it)
+        nerr += nmea_num_check(num_corpus[it], (int)rt_strlen(num_corpus[it]));
+
+    /* random fields like in sentences: [-]d{1,7}[.d{0,8}] */
+    srand(1);
+    for (it = 0; it < 100000; ++it)
+    {
+        len = 0;
+        if (rand() & 1)
+            str[len++] = '-';
+        for (pos = rand() % 7 + 1; pos; --pos)
+            str[len++] = '0' + rand() % 10;
+        if (rand() & 1)
+        {
+            str[len++] = '.';
+            for (pos = rand() % 9; pos; --pos)
+                str[len++] = '0' + rand() % 10;
+        }
+        nerr += nmea_num_check(str, len);
+    }
+
+    dbg_printf("num  : atof mismatches: %d\n", nerr);
+
+    nmea_atofix("-10.25", 6, 1, &fix);
+    dbg_printf("num  : atofix(-10.25, 1) = %d\n", (int)fix);
+    nmea_ndeg_atofix("3115.6422", 9, &fix);
+    dbg_printf("num  : ndeg 3115.6422 = %.9f, fix %d\n", nmea_ndeg_atof("3115.6422", 9), (int)fix);
+
+    /* out of range is an error, never a wrapped value */
+    nerr = nmea_atoi_checked("99999999999", 11, 10, &pos);
+    dbg_printf("num  : atoi overflow: %d, value %d, atoi(-2147483648) = %d\n",
+        nerr, pos, nmea_atoi("-2147483648", 11, 10));
+    dbg_printf("num  : atofix 9999999999999999999: %d, 2147483.648: %d, ndeg 99999999999999.9: %d (expected -1, -1, -1)\n",
+        nmea_atofix("9999999999999999999", 19, 0, &fix), nmea_atofix("2147483.648", 11, 3, &fix),
+        nmea_ndeg_atofix("99999999999999.9", 16, &fix));
+}
+
+MSH_CMD_EXPORT(nmea_parse_test_04, nmea number parsing test);
+
+const char *gnss_buff[] =
+{
+        "$GNRMC,031024.000,A,3115.6422,N,12127.5490,E,0.58,98.86,180918,,,A*44\r\n",
+        "$GNGGA,031024.000,3115.6422,N,12127.5490,E,1,12,0.9,10.2,M,0.0,M,,*44\r\n",
+        "$GBGSV,1,1,02,201,45,120,40,202,30,240,35*6F\r\n",
+        "$GLGSA,A,3,65,66,,,,,,,,,,,1.8,0.9,1.5*29\r\n",
+        "$GAVTG,98.86,T,,M,0.58,N,1.07,K*75\r\n"
+};
+
+static void nmea_talker_handler(int ptype, void *pack, void *user_data)
+{
+    /* talker is the first member of every packet structure */
+    dbg_printf("talker : type: 0x%02x, talker: %d\n", ptype, *(int *)pack);
+}
+
+void nmea_parse_test_05(void)
+{
+    int it, npack = 0;
+    nmea_info_t info = { 0 };
+    nmea_parser_t parser;
+
+    nmea_parser_init(&parser);
+    nmea_parser_set_handler(&parser, nmea_talker_handler, RT_NULL);
+
+    for (it = 0; it < sizeof(gnss_buff) / sizeof(gnss_buff[0]); ++it)
+        npack += nmea_parse_stream(&parser, gnss_buff[it], (int)rt_strlen(gnss_buff[it]), &info);
+
+    dbg_printf("talker : packets: %d of %d\n", npack, (int)(sizeof(gnss_buff) / sizeof(gnss_buff[0])));
+
+    nmea_parser_destroy(&parser);
+}
+
+MSH_CMD_EXPORT(nmea_parse_test_05, nmea parse multi-constellation test);
+
+const char *sat_buff[] =
+{
+        "$GPGSV,3,1,10,01,11,020,31,03,13,060,33,06,16,120,36,09,19,180,39,1*64\r\n",
+        "$GPGSV,3,2,10,12,22,240,42,14,24,280,44,17,27,340,47,19,29,020,49,1*65\r\n",
+        "$GPGSV,3,3,10,22,32,080,52,24,34,120,54,1*68\r\n",
+        "$GPGSV,1,1,02,01,11,020,31,03,13,060,33,6*67\r\n",
+        "$GPGSV,1,1,02,01,11,020,31,03,13,060,33,8*69\r\n",
+        "$GLGSV,2,1,06,65,20,095,25,66,20,102,25,72,20,144,25,73,20,151,25,1*74\r\n",
+        "$GLGSV,2,2,06,80,20,200,25,81,20,207,25,1*78\r\n",
+        "$GAGSV,2,1,07,02,30,022,35,07,30,077,35,11,30,121,35,19,30,209,35,7*73\r\n",
+        "$GAGSV,2,2,07,26,30,286,35,30,30,330,35,33,30,003,35,7*49\r\n",
+        "$GNGSA,A,3,01,03,06,09,12,14,,,,,,,1.2,0.8,0.9,1*38\r\n",
+        "$GNGSA,A,3,65,66,72,,,,,,,,,,1.2,0.8,0.9,2*36\r\n",
+        "$GNGSA,A,3,02,07,11,19,,,,,,,,,1.2,0.8,0.9,3*3C\r\n"
+};
+
+const char *sat_wrap_buff =
+        "$GPGSV,1,1,02,01,11,020,31,03,13,060,33,1*60\r\n"
+        "$GPGSA,A,3,01,03,,,,,,,,,,,1.2,0.8,0.9,1*2F\r\n";
+
+/* NMEA 4.00 combined talker: systems are mixed in one cycle, known by PRN */
+const char *sat_mixed_buff[] =
+{
+        "$GNGSV,2,1,06,01,40,083,46,03,30,100,40,65,20,200,30,66,25,210,31*6D\r\n",
+        "$GNGSV,2,2,06,202,45,120,40,70,35,300,33*55\r\n",
+        "$GNGSV,2,1,06,01,40,083,46,03,30,100,40,65,20,200,30,66,25,210,31*6D\r\n",
+        "$GNGSV,2,2,06,203,45,120,40,71,35,300,33*55\r\n"
+};
+
+void nmea_parse_test_06(void)
+{
+    int it, loop, nview, nuse;
+    nmea_info_t info = { 0 };
+    nmea_sat_table_t sattab;
+    nmea_parser_t parser;
+
+    nmea_parser_init(&parser);
+    nmea_sat_table_init(&sattab);
+    info.sattab = &sattab;
+
+    /* several epochs, table must not grow */
+    for (loop = 0; loop < 3; ++loop)
+    {
+        for (it = 0; it < sizeof(sat_buff) / sizeof(sat_buff[0]); ++it)
+            nmea_parse(&parser, sat_buff[it], (int)rt_strlen(sat_buff[it]), &info);
+    }
+
+    nview = nuse = 0;
+    for (it = 0; it < NMEA_SAT_TABLE_SIZE; ++it)
+    {
+        if (!sattab.sat[it].prn)
+            continue;
+        nview += nmea_sat_in_view(&sattab, &sattab.sat[it]);
+        nuse += nmea_sat_in_use(&sattab, &sattab.sat[it]);
+    }
+
+    dbg_printf("sat : entries: %d, in view: %d, in use: %d, overflow: %d (expected 27, 27, 17, 0)\n",
+        sattab.count, nview, nuse, (int)sattab.overflow);
+    dbg_printf("sat : info in view: %d, in use: %d, first id: %d (expected 23, 13, 0)\n",
+        info.satinfo.inview, info.satinfo.inuse, info.satinfo.sat[0].id);
+    dbg_printf("sat : GLONASS 72 sig: %d, Galileo 33 signal 7 azimuth: %d\n",
+        nmea_sat_table_find(&sattab, NMEA_SYSTEM_GLONASS, 72, 1)->sig,
+        nmea_sat_table_find(&sattab, NMEA_SYSTEM_GALILEO, 33, 7)->azimuth);
+
+    /* generation counters wrap, satellites dropped before must stay out */
+    for (loop = 0; loop < 256; ++loop)
+        nmea_parse(&parser, sat_wrap_buff, (int)rt_strlen(sat_wrap_buff), &info);
+    dbg_printf("sat : after wrap GPS 24 in view: %d, GPS 09 in use: %d, GPS 01 signal 8 in use: %d (expected 0, 0, 1)\n",
+        nmea_sat_in_view(&sattab, nmea_sat_table_find(&sattab, NMEA_SYSTEM_GPS, 24, 1)),
+        nmea_sat_in_use(&sattab, nmea_sat_table_find(&sattab, NMEA_SYSTEM_GPS, 9, 1)),
+        nmea_sat_in_use(&sattab, nmea_sat_table_find(&sattab, NMEA_SYSTEM_GPS, 1, 8)));
+
+    /* satellites which left the mixed cycle go out of view in every system */
+    nmea_sat_table_init(&sattab);
+    for (it = 0; it < 2; ++it)
+        nmea_parse(&parser, sat_mixed_buff[it], (int)rt_strlen(sat_mixed_buff[it]), &info);
+    for (loop = 0; loop < 2; ++loop)
+    {
+        for (it = 2; it < 4; ++it)
+            nmea_parse(&parser, sat_mixed_buff[it], (int)rt_strlen(sat_mixed_buff[it]), &info);
+    }
+    dbg_printf("sat : mixed cycle GLONASS 70 in view: %d, BeiDou 202 in view: %d, GLONASS 71 in view: %d (expected 0, 0, 1)\n",
+        nmea_sat_in_view(&sattab, nmea_sat_table_find(&sattab, NMEA_SYSTEM_GLONASS, 70, 0)),
+        nmea_sat_in_view(&sattab, nmea_sat_table_find(&sattab, NMEA_SYSTEM_BEIDOU, 202, 0)),
+        nmea_sat_in_view(&sattab, nmea_sat_table_find(&sattab, NMEA_SYSTEM_GLONASS, 71, 0)));
+
+    nmea_parser_destroy(&parser);
+}
+
+MSH_CMD_EXPORT(nmea_parse_test_06, nmea parse satellites table test);
+
+static void nmea_fix_handler(const nmea_info_t *fix, void *user_data)
+{
+    dbg_printf("epoch : %02d:%02d:%02d.%02d, mask: 0x%02x, Lat: %lf, Lon: %lf\n",
+        fix->utc.hour, fix->utc.min, fix->utc.sec, fix->utc.hsec, fix->smask,
+        nmea_coord2degree(fix->lat), nmea_coord2degree(fix->lon));
+}
+
+void nmea_parse_test_07(void)
+{
+    int it;
+    nmea_info_t info = { 0 };
+    nmea_epoch_t epoch;
+    nmea_parser_t parser;
+
+    nmea_parser_init(&parser);
+    nmea_epoch_init(&epoch, GPNON, nmea_fix_handler, RT_NULL);
+    nmea_parser_set_handler(&parser, nmea_epoch_pack_handler, &epoch);
+
+    for (it = 0; it < 8; ++it)
+        nmea_parse_stream(&parser, buff[it], (int)rt_strlen(buff[it]), &info);
+    nmea_epoch_flush(&epoch);
+
+    dbg_printf("epoch : fixes: %d\n", (int)epoch.count);
+
+    nmea_parser_destroy(&parser);
+}
+
+MSH_CMD_EXPORT(nmea_parse_test_07, nmea parse epoch assembler test);
+
+#define FIX_TEST_COUNT          (100000)
+
+static volatile int fix_writer_done;
+static rt_sem_t fix_writer_start;
+
+static void nmea_fix_writer(void *parameter)
+{
+    nmea_fix_pub_t *pub = (nmea_fix_pub_t *)parameter;
+    nmea_info_t fix = { 0 };
+    int it;
+
+    /* reader is running when the first fix is published */
+    rt_sem_take(fix_writer_start, RT_WAITING_FOREVER);
+
+    /* every fix is consistent: all fields carry the same number */
+    for (it = 1; it <= FIX_TEST_COUNT; ++it)
+    {
+        fix.smask = it;
+        fix.lat = (nmea_coord_t)it;
+        fix.lon = (nmea_coord_t)it;
+        fix.elv = (nmea_dist_t)it;
+        fix.utc.sec = it;
+        nmea_fix_publish(pub, &fix);
+    }
+
+    fix_writer_done = 1;
+}
+
+void nmea_parse_test_08(void)
+{
+    static nmea_fix_pub_t pub;
+    nmea_info_t fix;
+    rt_thread_t tid;
+    rt_uint32_t seq, last_seq = 0;
+    int nread = 0, nbad = 0, nbusy = 0, res, done;
+
+    nmea_fix_pub_init(&pub);
+    fix_writer_done = 0;
+
+    fix_writer_start = rt_sem_create("nmeafix", 0, RT_IPC_FLAG_FIFO);
+    if (!fix_writer_start)
+        return;
+    tid = rt_thread_create("nmeafix", nmea_fix_writer, &pub, 2048,
+        rt_thread_self()->current_priority, 1);
+    if (!tid)
+    {
+        rt_sem_delete(fix_writer_start);
+        return;
+    }
+    rt_thread_startup(tid);
+    rt_sem_release(fix_writer_start);
+
+    /* one more read after writer is done, it must see the last fix */
+    do
+    {
+        done = fix_writer_done;
+        res = nmea_fix_read(&pub, &fix, &seq);
+        if (res < 0)
+            nbusy++;
+        if (res <= 0)
+            continue;
+
+        nread++;
+        if (fix.smask != (int)seq || fix.lat != (nmea_coord_t)fix.smask ||
+            fix.lon != (nmea_coord_t)fix.smask || fix.elv != (nmea_dist_t)fix.smask ||
+            fix.utc.sec != fix.smask || seq < last_seq)
+            nbad++;
+        last_seq = seq;
+    } while (!done);
+
+    rt_sem_delete(fix_writer_start);
+
+    dbg_printf("fix : reads: %d, torn: %d, busy: %d, last: %d\n", nread, nbad, nbusy, (int)last_seq);
+    if (!nread || nbad || last_seq != FIX_TEST_COUNT)
+        dbg_printf("fix : FAILED (expected reads > 0, torn 0, last %d)\n", FIX_TEST_COUNT);
+}
+
+MSH_CMD_EXPORT(nmea_parse_test_08, nmea fix publication test);
+
+void nmea_parse_test_09(void)
+{
+    static const char noise[] = "$*\r\n,.0A\x80\xff";
+    char sen[DBG_BUFF_MAX_LEN];
+    int it, pos, len, nmut, ndiff = 0;
+    int crc_ref, crc_fast, nread_ref, nread_fast;
+
+    srand(2);
+    for (it = 0; it < 100000; ++it)
+    {
+        const char *src = buff[rand() % 8];
+
+        /* corpus sentence, optionally mutated and truncated */
+        len = (int)rt_strlen(src);
+        rt_memcpy(sen, src, len);
+        for (nmut = rand() % 3; nmut; --nmut)
+            sen[rand() % len] = noise[rand() % (sizeof(noise) - 1)];
+        if (rand() & 1)
+            len = rand() % (len + 1);
+
+        pos = (rand() & 3) ? 0 : rand() % (len + 1);
+
+        nread_ref = nmea_find_tail_ref(sen + pos, len - pos, &crc_ref);
+        nread_fast = nmea_find_tail(sen + pos, len - pos, &crc_fast);
+        if (nread_ref != nread_fast || crc_ref != crc_fast)
+            ndiff++;
+    }
+
+    dbg_printf("tail : find_tail differs from reference: %d\n", ndiff);
+}
+
+MSH_CMD_EXPORT(nmea_parse_test_09, nmea find tail cross-check test);
+
+#define BATCH_TEST_RECORDS      (4)
+
+void nmea_parse_test_10(void)
+{
+    static char log[2048];
+    static const char bad[] = "$GPRMC,111609.14,A,5001.27,N,3613.06,E,11.2,0.0,261206,0.0,E*00\r\n";
+    rt_uint32_t offset[BATCH_TEST_RECORDS], err_offset[4];
+    rt_int32_t utc_ms[BATCH_TEST_RECORDS], date[BATCH_TEST_RECORDS];
+    rt_uint8_t sig[BATCH_TEST_RECORDS];
+    nmea_batch_t batch;
+    int it, rep, part, len = 0, pos = 0, end, nread, nrec = 0, nerr = 0;
+
+    /* log of three passes of corpus with one broken sentence */
+    for (rep = 0; rep < 3; ++rep)
+    {
+        for (it = 0; it < 8; ++it)
+        {
+            rt_memcpy(log + len, buff[it], rt_strlen(buff[it]));
+            len += (int)rt_strlen(buff[it]);
+        }
+    }
+    rt_memcpy(log + len, bad, sizeof(bad) - 1);
+    len += sizeof(bad) - 1;
+
+    nmea_batch_init(&batch, BATCH_TEST_RECORDS, GPNON);
+    batch.offset = offset;
+    batch.utc_ms = utc_ms;
+    batch.date = date;
+    batch.sig = sig;
+    batch.err_offset = err_offset;
+    batch.err_capacity = sizeof(err_offset) / sizeof(err_offset[0]);
+
+    /* input comes in two parts, the first one cuts sentence */
+    for (part = 0; part < 2; ++part)
+    {
+        end = part ? len : 300;
+        do
+        {
+            nread = nmea_parse_batch(&batch, log + pos, end - pos);
+            pos += nread;
+            if (pos >= len)
+                nmea_batch_flush(&batch);
+
+            for (it = 0; it < batch.count; ++it)
+                dbg_printf("batch : offset: %4d, utc: %8d ms, date: %8d, sig: %d\n",
+                    (int)offset[it], (int)utc_ms[it], (int)date[it], sig[it]);
+            for (it = 0; it < batch.err_count; ++it)
+                dbg_printf("batch : broken sentence at %d\n", (int)err_offset[it]);
+            nrec += batch.count;
+            nerr += batch.err_count;
+            nmea_batch_reset(&batch);
+        } while (nread && pos < end);
+    }
+
+    dbg_printf("batch : records: %d, errors: %d, bytes: %d of %d\n", nrec, nerr, pos, len);
+}
+
+MSH_CMD_EXPORT(nmea_parse_test_10, nmea batch parse test);
+
+#define PARALLEL_TEST_PASSES    (20)
+#define PARALLEL_TEST_RECORDS   (128)
+
+void nmea_parse_test_11(void)
+{
+    static const int last_types[] = { GPNON, GPGGA };
+    static char log[PARALLEL_TEST_PASSES * 600];
+    static rt_uint32_t offset[2][PARALLEL_TEST_RECORDS];
+    static rt_int32_t utc_ms[2][PARALLEL_TEST_RECORDS];
+    static rt_uint8_t sig[2][PARALLEL_TEST_RECORDS];
+    static nmea_dist_t alt[2][PARALLEL_TEST_RECORDS];
+    static nmea_centi_t hdop[2][PARALLEL_TEST_RECORDS];
+    nmea_batch_t batch;
+    int it, rep, lt, nthreads, len = 0, pos, nread, nrec, ndiff;
+
+    for (rep = 0; rep < PARALLEL_TEST_PASSES; ++rep)
+    {
+        for (it = 0; it < 8; ++it)
+        {
+            rt_memcpy(log + len, buff[it], rt_strlen(buff[it]));
+            len += (int)rt_strlen(buff[it]);
+        }
+    }
+
+    for (lt = 0; lt < (int)(sizeof(last_types) / sizeof(last_types[0])); ++lt)
+    {
+        /* serial parse is reference */
+        nmea_batch_init(&batch, PARALLEL_TEST_RECORDS, last_types[lt]);
+        batch.offset = offset[0];
+        batch.utc_ms = utc_ms[0];
+        batch.sig = sig[0];
+        batch.alt = alt[0];
+        batch.hdop = hdop[0];
+        nmea_parse_batch(&batch, log, len);
+        nmea_batch_flush(&batch);
+        nrec = batch.count;
+
+        for (nthreads = 1; nthreads <= 4; ++nthreads)
+        {
+            /* small output arrays, parse continues after full output */
+            nmea_batch_init(&batch, 7, last_types[lt]);
+            ndiff = 0;
+            for (pos = 0, it = 0; pos < len && it < PARALLEL_TEST_RECORDS; pos += nread)
+            {
+                batch.offset = offset[1] + it;
+                batch.utc_ms = utc_ms[1] + it;
+                batch.sig = sig[1] + it;
+                batch.alt = alt[1] + it;
+                batch.hdop = hdop[1] + it;
+                nread = nmea_parse_parallel(&batch, log + pos, len - pos, nthreads);
+                it += batch.count;
+                nmea_batch_reset(&batch);
+                if (!nread)
+                    break;
+            }
+
+            ndiff += (it != nrec);
+            for (it = 0; it < nrec; ++it)
+                ndiff += (offset[0][it] != offset[1][it] || utc_ms[0][it] != utc_ms[1][it] ||
+                    sig[0][it] != sig[1][it] || alt[0][it] != alt[1][it] || hdop[0][it] != hdop[1][it]);
+            dbg_printf("parallel : last type: 0x%02X, threads: %d, records: %d, differ from serial: %d, bytes: %d of %d\n",
+                last_types[lt], nthreads, nrec, ndiff, pos, len);
+        }
+    }
+}
+
+MSH_CMD_EXPORT(nmea_parse_test_11, nmea parallel batch parse test);
+
+void nmea_parse_test_12(void)
+{
+    static const char bad[] = "$GPGSV,2,2,08,05,05,185,80,06,05,230,80,07,05,275,80,08,05,320,80*00\r\n";
+    nmea_info_t info = { 0 };
+    nmea_parser_t parser;
+    int it, fast, npack, bit;
+
+    for (fast = 0; fast < 2; ++fast)
+    {
+        nmea_parser_init(&parser);
+        nmea_parser_set_filter(&parser, GPGGA | GPRMC, fast);
+
+        npack = 0;
+        for (it = 0; it < 8; ++it)
+            npack += nmea_parse(&parser, buff[it], (int)rt_strlen(buff[it]), &info);
+        npack += nmea_parse(&parser, bad, sizeof(bad) - 1, &info);
+
+        dbg_printf("filter : fast: %d, packets: %d, crc errors: %d, dropped:", fast, npack, (int)parser.crc_error);
+        for (bit = 0; bit < NMEA_PACK_TYPE_COUNT; ++bit)
+            dbg_printf(" %d", (int)parser.filter_drop[bit]);
+        dbg_printf("\n");
+
+        nmea_parser_destroy(&parser);
+    }
+}
+
+MSH_CMD_EXPORT(nmea_parse_test_12, nmea parse sentence filter test);
+
+static void nmea_view_handler(const nmea_sentence_view_t *view, void *user_data)
+{
+    nmea_sentence_view_t copy;
+    nmea_time_t utc = { 0 };
+    const char *addr;
+    int len, *count = (int *)user_data;
+
+    count[0]++;
+    /* index built by framing and by scan must match */
+    if (!nmea_view_init(&copy, view->buff, view->buff_sz) || copy.field_count != view->field_count ||
+        rt_memcmp(copy.field_off, view->field_off, (view->field_count + 1) * sizeof(rt_uint16_t)))
+        count[1]++;
+
+    addr = nmea_view_field(view, 0, &len);
+    switch (view->ptype)
+    {
+    case GPGGA:
+        nmea_view_get_time(view, 1, &utc);
+        dbg_printf("view : %.*s, utc: %02d:%02d:%02d, lat: %lf, lon: %lf, sats: %d\n", len, addr,
+            utc.hour, utc.min, utc.sec, nmea_coord2degree(nmea_view_get_latlon(view, 2)),
+            nmea_coord2degree(nmea_view_get_latlon(view, 4)), nmea_view_get_int(view, 7));
+        break;
+    case GPRMC:
+        nmea_view_get_time(view, 1, &utc);
+        dbg_printf("view : %.*s, utc: %02d:%02d:%02d, status: %c, speed: %lf\n", len, addr,
+            utc.hour, utc.min, utc.sec, nmea_view_get_char(view, 2), nmea_view_get_double(view, 7));
+        break;
+    case GPNON:
+        dbg_printf("view : %.*s, fields: %d, first: %lf %c\n", len, addr, view->field_count,
+            nmea_view_get_double(view, 1), nmea_view_get_char(view, 2));
+        break;
+    default:
+        dbg_printf("view : %.*s, fields: %d\n", len, addr, view->field_count);
+        break;
+    };
+}
+
+void nmea_parse_test_13(void)
+{
+    static const char prop[] = "$PGRME,15.0,M,45.0,M,25.0,M*1C\r\n";
+    nmea_parser_t parser;
+    int it, count[2] = { 0 };
+
+    nmea_parser_init(&parser);
+
+    for (it = 0; it < 8; ++it)
+        nmea_parse_view(&parser, buff[it], (int)rt_strlen(buff[it]), nmea_view_handler, count);
+    nmea_parse_view(&parser, prop, sizeof(prop) - 1, nmea_view_handler, count);
+
+    dbg_printf("view : sentences: %d, index mismatch: %d\n", count[0], count[1]);
+
+    nmea_parser_destroy(&parser);
+}
+
+MSH_CMD_EXPORT(nmea_parse_test_13, nmea parse sentence view test);
+
+void nmea_parse_test_14(void)
+{
+    nmea_time_t leap = { 116, 11, 31, 23, 59, 60, 0 };
+    nmea_time_t next = { 117, 0, 1, 0, 0, 0, 0 };
+    nmea_rmc_t pack = { 0 };
+    rt_int64_t unix_ms;
+    rt_int32_t tow_ms;
+    int week;
+
+    /* 2018-09-18 03:10:24 UTC */
+    nmea_parse_rmc(buff[7], (int)rt_strlen(buff[7]), &pack);
+    unix_ms = nmea_time_unix_ms(&pack.utc);
+    week = nmea_time_gps_week(&pack.utc, NMEA_LEAP_SECONDS_AUTO, &tow_ms);
+    dbg_printf("time : unix: %s, week: %d, tow: %d ms (expected 2019, 184242000)\n",
+        (1537240224000LL == unix_ms) ? "ok" : "wrong", week, (int)tow_ms);
+
+    /* GPS time goes on through inserted second 2016-12-31 23:59:60 */
+    dbg_printf("time : leap: %d -> %d, gps step: %d ms\n",
+        nmea_time_leap_seconds(nmea_time_unix_ms(&leap) - 1000), nmea_time_leap_seconds(nmea_time_unix_ms(&next)),
+        (int)(nmea_time_gps_ms(&next, NMEA_LEAP_SECONDS_AUTO) - nmea_time_gps_ms(&leap, NMEA_LEAP_SECONDS_AUTO)));
+}
+
+MSH_CMD_EXPORT(nmea_parse_test_14, nmea utc time conversion test);
+
+static void nmea_gsv_view_handler(const nmea_gsv_view_t *view, void *user_data)
+{
+    dbg_printf("gsv : view talker: %d, signal: %d, in view: %d, first prn: %d\n",
+        view->talker, view->signal_id, view->sat_count, view->sat[0].id);
+}
+
+void nmea_parse_test_15(void)
+{
+    nmea_gsv_asm_t gsv_asm;
+    nmea_gsv_t pack[2];
+    int it;
+
+    nmea_gsv_asm_init(&gsv_asm, nmea_gsv_view_handler, RT_NULL);
+    nmea_parse_gsv(buff[2], (int)rt_strlen(buff[2]), &pack[0]);
+    nmea_parse_gsv(buff[3], (int)rt_strlen(buff[3]), &pack[1]);
+
+    /* the same sky twice, published once */
+    for (it = 0; it < 4; ++it)
+        nmea_gsv_asm_input(&gsv_asm, &pack[it & 1]);
+
+    /* message 2 is lost, then cycle with changed signal */
+    nmea_gsv_asm_input(&gsv_asm, &pack[0]);
+    pack[1].sat_data[0].sig = 42;
+    nmea_gsv_asm_input(&gsv_asm, &pack[0]);
+    nmea_gsv_asm_input(&gsv_asm, &pack[1]);
+
+    dbg_printf("gsv : complete: %d, published: %d, incomplete: %d (expected 3, 2, 1)\n",
+        (int)gsv_asm.complete, (int)gsv_asm.published, (int)gsv_asm.incomplete);
+}
+
+MSH_CMD_EXPORT(nmea_parse_test_15, nmea gsv cycle assembly test);
+
+const char *ext_buff[] =
+{
+        "$GPGLL,3751.65,S,14507.36,E,225444,A,A*5A\r\n",
+        "$GPZDA,201530.00,04,07,2002,-05,00*48\r\n",
+        "$GPGST,172814.0,0.006,0.023,0.020,273.6,0.023,0.020,0.031*6A\r\n",
+        "$GNGNS,014035.00,4332.69262,S,17235.48549,E,RR,13,0.9,25.63,11.24,,,V*0A\r\n",
+        "$GPGRS,220320.0,0,-0.8,-0.2,-0.1,-0.2,0.8,0.6,,,,,,,1,1*79\r\n",
+        "$GPDTM,W84,,0.0,N,0.0,E,0.0,W84*6F\r\n",
+        "$GPHDT,274.07,T*03\r\n"
+};
+
+const char *bad_date_buff = "$GNRMC,031024.000,A,3115.6422,N,12127.5490,E,0.58,98.86,18O918,,,A*3B\r\n";
+
+void nmea_parse_test_16(void)
+{
+    nmea_info_t info = { 0 };
+    nmea_parser_t parser;
+    nmea_pack_t pack;
+    int it, npack = 0;
+
+    nmea_parser_init(&parser);
+    for (it = 0; it < (int)(sizeof(ext_buff) / sizeof(ext_buff[0])); ++it)
+        npack += nmea_parse(&parser, ext_buff[it], (int)rt_strlen(ext_buff[it]), &info);
+    nmea_parser_destroy(&parser);
+
+    dbg_printf("ext : packs: %d, smask: 0x%04X (expected 7, 0x0FE0)\n", npack, info.smask);
+    dbg_printf("ext : date: %d-%02d-%02d, zone: %d min, datum: %s (expected 2002-07-04, -300, W84)\n",
+        info.utc.year + 1900, info.utc.mon + 1, info.utc.day, info.zone_min, info.datum);
+    dbg_printf("ext : GNS Lat: %lf, Lon: %lf, Sig: %d, Elv: %.2lf (expected 4)\n",
+        nmea_coord2degree(info.lat), nmea_coord2degree(info.lon), info.sig, nmea_dist2meter(info.elv));
+    dbg_printf("ext : rms: %.3lf, orient: %.1lf, heading: %.2lf\n",
+        nmea_dist2meter(info.rms), nmea_centi2double(info.err_orient), nmea_centi2double(info.heading));
+
+    nmea_pack_decode(GPGRS, ext_buff[4], (int)rt_strlen(ext_buff[4]), &pack);
+    dbg_printf("ext : GRS residual[0]: %.1lf, system: %d, signal: %d (expected -0.8, 1, 1)\n",
+        nmea_dist2meter(pack.grs.residual[0]), pack.grs.system_id, pack.grs.signal_id);
+
+    it = (int)rt_strlen(bad_date_buff);
+    dbg_printf("ext : RMC with letter in date decoded: %d (expected 0)\n", nmea_pack_decode(GPRMC, bad_date_buff, it, &pack));
+}
+
+MSH_CMD_EXPORT(nmea_parse_test_16, nmea extended sentence decoders test);
+
+const char *prop_buff =
+        "$PUBX,00,081350.00,4717.113210,N,00833.915187,E,546.589,G3,2.1,2.0,0.007,77.52,0.007,,0.92,1.19,0.77,9,0,0*5F\r\n"
+        "$PUBX,04,073731.00,091202,113851.00,1196,15D,1930035,-2660.664,43*71\r\n"
+        "$GPRMC,173843,A,3349.896,N,11808.521,W,000.0,360.0,230108,013.4,E*69\r\n"
+        "$PMTK001,314,3*36\r\n"
+        "$PQTMEPE,2,1.000,1.000,2.000,1.414,2.449*5D\r\n"
+        "$GNEPE,1.21,2.35*5F\r\n";
+
+static void nmea_prop_handler(const nmea_sentence_view_t *view, void *user_data)
+{
+    int len;
+    const char *id = nmea_view_field(view, 1, &len);
+
+    dbg_printf("prop : %s handler, fields: %d, field 1: %.*s\n",
+        (const char *)user_data, view->field_count, len, id);
+}
+
+void nmea_parse_test_17(void)
+{
+    nmea_info_t info = { 0 };
+    nmea_parser_t parser;
+    int npack;
+
+    nmea_parser_init(&parser);
+    nmea_parser_register_sentence(&parser, "PUBX", nmea_prop_handler, "PUBX");
+    nmea_parser_register_sentence(&parser, "PUBX,00", nmea_prop_handler, "PUBX,00");
+    nmea_parser_register_sentence(&parser, "PMTK", nmea_prop_handler, "PMTK");
+    nmea_parser_register_sentence(&parser, "PQTMEPE", nmea_prop_handler, "PQTMEPE");
+    nmea_parser_register_sentence(&parser, "GNEPE", nmea_prop_handler, "GNEPE");
+
+    npack = nmea_parse_stream(&parser, prop_buff, (int)rt_strlen(prop_buff), &info);
+    dbg_printf("prop : packs: %d, proprietary: %d (expected 1, 5)\n", npack, (int)parser.prop_count);
+
+    /* next sentence is half received when the cached one is polled */
+    nmea_parser_feed(&parser, prop_buff + 251, 19 + 19);
+    nmea_parser_poll(&parser, &info);
+    dbg_printf("prop : polled proprietary: %d (expected 6, fields: 2, field 1: 314)\n", (int)parser.prop_count);
+    nmea_parser_destroy(&parser);
+}
+
+MSH_CMD_EXPORT(nmea_parse_test_17, nmea proprietary sentence registry test);
+
+static void nmea_test_put32(rt_uint8_t *ptr, rt_uint32_t val)
+{
+    ptr[0] = (rt_uint8_t)val;
+    ptr[1] = (rt_uint8_t)(val >> 8);
+    ptr[2] = (rt_uint8_t)(val >> 16);
+    ptr[3] = (rt_uint8_t)(val >> 24);
+}
+
+/**
+ * \brief Build UBX frame around payload
+ * @return Frame size
+ */
+static int nmea_test_ubx_frame(rt_uint8_t *frame, int msg_id, const rt_uint8_t *payload, int payload_sz)
+{
+    rt_uint16_t ck;
+
+    frame[0] = 0xB5;
+    frame[1] = 0x62;
+    frame[2] = (rt_uint8_t)(msg_id >> 8);
+    frame[3] = (rt_uint8_t)msg_id;
+    frame[4] = (rt_uint8_t)payload_sz;
+    frame[5] = (rt_uint8_t)(payload_sz >> 8);
+    rt_memcpy(frame + 6, payload, payload_sz);
+    ck = nmea_ubx_checksum(frame + 2, payload_sz + 4);
+    frame[6 + payload_sz] = (rt_uint8_t)ck;
+    frame[7 + payload_sz] = (rt_uint8_t)(ck >> 8);
+
+    return payload_sz + 8;
+}
+
+void nmea_parse_test_18(void)
+{
+    nmea_info_t info = { 0 };
+    nmea_parser_t parser;
+    rt_uint8_t pvt[NMEA_UBX_NAV_PVT_SIZE] = { 0 }, sat[8 + 2 * 12] = { 0 };
+    static rt_uint8_t stream[1024];
+    int len = 0, pos, chunk, npack = 0;
+
+    /* time of week bytes look like '$' and '*' */
+    nmea_test_put32(pvt, 0x2A242A24);
+    pvt[4] = 0xE8; pvt[5] = 0x07; pvt[6] = 3; pvt[7] = 5;
+    pvt[8] = 12; pvt[9] = 30; pvt[10] = 15; pvt[11] = 0x07;
+    nmea_test_put32(pvt + 16, 500000000);
+    pvt[20] = 3; pvt[21] = 0x01; pvt[23] = 12;
+    nmea_test_put32(pvt + 24, 1214125000);
+    nmea_test_put32(pvt + 28, 312345678);
+    nmea_test_put32(pvt + 36, 25630);
+    nmea_test_put32(pvt + 60, 1000);
+    nmea_test_put32(pvt + 64, 9000000);
+    pvt[76] = 150;
+
+    sat[5] = 2;
+    sat[8] = 0; sat[9] = 5; sat[10] = 42; sat[11] = 60; sat[12] = 90; sat[16] = 0x08;
+    sat[20] = 6; sat[21] = 3; sat[22] = 30; sat[23] = 15; sat[24] = 0x0E; sat[25] = 0x01;
+
+    rt_memcpy(stream + len, buff[1], rt_strlen(buff[1]));
+    len += (int)rt_strlen(buff[1]);
+    len += nmea_test_ubx_frame(stream + len, NMEA_UBX_NAV_SAT, sat, sizeof(sat));
+    /* broken frame, sentence after it must survive */
+    pos = len;
+    len += nmea_test_ubx_frame(stream + len, NMEA_UBX_NAV_SAT, sat, sizeof(sat));
+    stream[pos + 10] ^= 0xFF;
+    rt_memcpy(stream + len, buff[6], rt_strlen(buff[6]));
+    len += (int)rt_strlen(buff[6]);
+    /* fix of the frame replaces the one of GGA */
+    len += nmea_test_ubx_frame(stream + len, NMEA_UBX_NAV_PVT, pvt, sizeof(pvt));
+
+    /* satellite left by longer list before */
+    info.satinfo.sat[2].id = 99;
+
+    nmea_parser_init(&parser);
+    nmea_parser_set_ubx_handler(&parser, nmea_ubx_info_handler, &info);
+    for (pos = 0; pos < len; pos += chunk)
+    {
+        chunk = (len - pos < 7) ? len - pos : 7;
+        npack += nmea_parse_stream(&parser, (const char *)stream + pos, chunk, &info);
+    }
+
+    dbg_printf("ubx : packs: %d, frames: %d, crc errors: %d (expected 2, 2, 1)\n",
+        npack, (int)parser.ubx_count, (int)parser.ubx_crc_error);
+    dbg_printf("ubx : PVT Lat: %lf, Lon: %lf, Elv: %.2lf, %d-%02d-%02d %02d:%02d:%02d.%02d\n",
+        nmea_coord2degree(info.lat), nmea_coord2degree(info.lon), nmea_dist2meter(info.elv),
+        info.utc.year + 1900, info.utc.mon + 1, info.utc.day, info.utc.hour, info.utc.min, info.utc.sec, info.utc.hsec);
+    dbg_printf("ubx : SAT in view: %d, in use: %d, ids: %d %d %d (expected 2, 12 of PVT, 5 67 0)\n",
+        info.satinfo.inview, info.satinfo.inuse, info.satinfo.sat[0].id, info.satinfo.sat[1].id, info.satinfo.sat[2].id);
+    nmea_parser_destroy(&parser);
+}
+
+MSH_CMD_EXPORT(nmea_parse_test_18, nmea mixed ubx stream test);
+
+/**
+ * \brief Build RTCM3 frame of message type with payload filled by pattern
+ * @return Frame size
+ */
+static int nmea_test_rtcm_frame(rt_uint8_t *frame, int msg_type, int payload_sz)
+{
+    rt_uint32_t crc;
+    int it;
+
+    frame[0] = NMEA_RTCM_PREAMBLE;
+    frame[1] = (rt_uint8_t)(payload_sz >> 8);
+    frame[2] = (rt_uint8_t)payload_sz;
+    for (it = 0; it < payload_sz; ++it)
+        frame[3 + it] = (rt_uint8_t)(it * 7 + 0x24);
+    frame[3] = (rt_uint8_t)(msg_type >> 4);
+    frame[4] = (rt_uint8_t)((msg_type << 4) | (frame[4] & 0x0F));
+    crc = nmea_crc24q(0, frame, 3 + payload_sz);
+    frame[3 + payload_sz] = (rt_uint8_t)(crc >> 16);
+    frame[4 + payload_sz] = (rt_uint8_t)(crc >> 8);
+    frame[5 + payload_sz] = (rt_uint8_t)crc;
+
+    return NMEA_RTCM_FRAME_SIZE(payload_sz);
+}
+
+typedef struct _nmea_test_rtcm_log
+{
+    rt_uint8_t data[1024];
+    int len;
+    int types[4];
+    int count;
+} nmea_test_rtcm_log_t;
+
+static void nmea_test_rtcm_sink(const rt_uint8_t *frame, int frame_sz, void *user_data)
+{
+    nmea_test_rtcm_log_t *log = (nmea_test_rtcm_log_t *)user_data;
+
+    if (log->len + frame_sz <= (int)sizeof(log->data))
+    {
+        rt_memcpy(log->data + log->len, frame, frame_sz);
+        log->len += frame_sz;
+    }
+    if (log->count < 4)
+        log->types[log->count] = nmea_rtcm_msg_type(frame);
+    log->count++;
+}
+
+void nmea_parse_test_19(void)
+{
+    static rt_uint8_t stream[1024], frames[1024];
+    static nmea_test_rtcm_log_t log;
+    nmea_info_t info = { 0 };
+    nmea_parser_t parser;
+    int len = 0, nframe = 0, pos, chunk, mode, npack;
+
+    dbg_printf("rtcm : crc24q: 0x%06X (expected 0xCDE703)\n",
+        (unsigned)nmea_crc24q(0, (const rt_uint8_t *)"123456789", 9));
+
+    rt_memcpy(stream + len, buff[1], rt_strlen(buff[1]));
+    len += (int)rt_strlen(buff[1]);
+    pos = nmea_test_rtcm_frame(stream + len, 1005, 19);
+    rt_memcpy(frames + nframe, stream + len, pos);
+    nframe += pos;
+    len += pos;
+    pos = nmea_test_rtcm_frame(stream + len, 1077, 300);
+    rt_memcpy(frames + nframe, stream + len, pos);
+    nframe += pos;
+    len += pos;
+    /* broken frame, sentence after it must survive */
+    pos = nmea_test_rtcm_frame(stream + len, 1230, 8);
+    stream[len + 5] ^= 0x01;
+    len += pos;
+    rt_memcpy(stream + len, buff[6], rt_strlen(buff[6]));
+    len += (int)rt_strlen(buff[6]);
+
+    /* whole buffer at once, then split into small reads */
+    for (mode = 0; mode < 2; ++mode)
+    {
+        rt_memset(&log, 0, sizeof(log));
+        nmea_parser_init(&parser);
+        nmea_parser_set_rtcm_sink(&parser, nmea_test_rtcm_sink, &log);
+
+        npack = 0;
+        for (pos = 0; pos < len; pos += chunk)
+        {
+            chunk = (mode && len - pos > 7) ? 7 : len - pos;
+            npack += nmea_parse_stream(&parser, (const char *)stream + pos, chunk, &info);
+        }
+
+        dbg_printf("rtcm : packs: %d, frames: %d, direct: %d, crc errors: %d, types: %d %d, same bytes: %s\n",
+            npack, (int)parser.rtcm_count, (int)parser.rtcm_direct, (int)parser.rtcm_crc_error,
+            log.types[0], log.types[1], (log.len == nframe && 0 == rt_memcmp(log.data, frames, nframe)) ? "yes" : "no");
+        nmea_parser_destroy(&parser);
+    }
+    dbg_printf("rtcm : expected packs: 2, frames: 2, direct: 2 then 0, crc errors: 1, types: 1005 1077\n");
+}
+
+MSH_CMD_EXPORT(nmea_parse_test_19, nmea rtcm3 pass-through test);
+
+/**
+ * \brief Fill satellites table as GSV and GSA of system would do
+ */
+static void nmea_test_sat_system(nmea_sat_table_t *tab, int talker, int system_id, int prn0, int nview, int nuse)
+{
+    nmea_gsv_t gsv = { 0 };
+    nmea_gsa_t gsa = { 0 };
+    int isat;
+
+    gsv.talker = talker;
+    gsv.sat_count = nview;
+    gsv.pack_count = (nview + NMEA_SATINPACK - 1) / NMEA_SATINPACK;
+    for (isat = 0; isat < nview; ++isat)
+    {
+        gsv.pack_index = isat / NMEA_SATINPACK + 1;
+        gsv.sat_data[isat % NMEA_SATINPACK].id = prn0 + isat;
+        gsv.sat_data[isat % NMEA_SATINPACK].elv = 10 + isat * 5;
+        gsv.sat_data[isat % NMEA_SATINPACK].azimuth = isat * 25;
+        gsv.sat_data[isat % NMEA_SATINPACK].sig = 30 + isat;
+        if (isat % NMEA_SATINPACK == NMEA_SATINPACK - 1 || isat == nview - 1)
+        {
+            nmea_sat_table_gsv(tab, &gsv);
+            rt_memset(gsv.sat_data, 0, sizeof(gsv.sat_data));
+        }
+    }
+
+    /* GSA has up to 12 satellites, the rest goes to the next one */
+    gsa.talker = NMEA_TALKER_GN;
+    gsa.system_id = system_id;
+    for (isat = 0; isat < nuse && isat < NMEA_MAXSAT; ++isat)
+        gsa.sat_prn[isat] = prn0 + isat;
+    nmea_sat_table_gsa(tab, &gsa);
+}
+
+static void nmea_test_sat_count(const nmea_sat_table_t *tab, int system, int *nview, int *nuse)
+{
+    int it;
+
+    *nview = *nuse = 0;
+    for (it = 0; it < NMEA_SAT_TABLE_SIZE; ++it)
+    {
+        if (!tab->sat[it].prn || tab->sat[it].system != system || !nmea_sat_in_view(tab, &tab->sat[it]))
+            continue;
+        (*nview)++;
+        *nuse += nmea_sat_in_use(tab, &tab->sat[it]);
+    }
+}
+
+void nmea_parse_test_20(void)
+{
+    static char out[2048];
+    static nmea_sat_table_t tab, tab_rx;
+    nmea_info_t info = { 0 }, info_rx = { 0 };
+    nmea_parser_t parser;
+    nmea_gga_t gga;
+    char *line, *end;
+    int it, len, npack, nview, nuse;
+
+    /* fix of sample sentences, generated by GN talker and parsed back */
+    nmea_parser_init(&parser);
+    for (it = 1; it < 7; ++it)
+        nmea_parse(&parser, buff[it], (int)rt_strlen(buff[it]), &info);
+    nmea_parser_destroy(&parser);
+
+    len = nmea_generate(out, sizeof(out), &info, NMEA_TALKER_GN, GPGGA | GPGSA | GPGSV | GPRMC | GPVTG);
+    for (line = out; line < out + len; line = end + 1)
+    {
+        end = line;
+        while (*end != '\n')
+            end++;
+        dbg_printf("gen : %.*s\n", (int)(end - line - 1), line);
+    }
+
+    /* GSA marks satellites of previous GSV, so the second cycle has them in use */
+    nmea_parser_init(&parser);
+    nmea_parse(&parser, out, len, &info_rx);
+    npack = nmea_parse(&parser, out, len, &info_rx);
+    dbg_printf("gen : packs: %d, crc errors: %d, Lat: %lf, Lon: %lf, Elv: %.1lf, Speed: %.1lf, in view: %d, in use: %d\n",
+        npack, (int)parser.crc_error, nmea_coord2degree(info_rx.lat), nmea_coord2degree(info_rx.lon),
+        nmea_dist2meter(info_rx.elv), nmea_centi2double(info_rx.speed), info_rx.satinfo.inview, info_rx.satinfo.inuse);
+    dbg_printf("gen : expected packs: 6, crc errors: 0, Lat: %lf, Lon: %lf, Elv: %.1lf, Speed: %.1lf, in view: %d, in use: %d\n",
+        nmea_coord2degree(info.lat), nmea_coord2degree(info.lon), nmea_dist2meter(info.elv),
+        nmea_centi2double(info.speed), info.satinfo.inview, info.satinfo.inuse);
+    nmea_parser_destroy(&parser);
+
+    /* 14 GPS and 6 GLONASS satellites, more than GSA and info->satinfo have room for */
+    nmea_sat_table_init(&tab);
+    nmea_test_sat_system(&tab, NMEA_TALKER_GP, NMEA_SYSTEM_GPS, 1, 14, 12);
+    nmea_test_sat_system(&tab, NMEA_TALKER_GL, NMEA_SYSTEM_GLONASS, 65, 6, 4);
+    info.sattab = &tab;
+    len = nmea_generate(out, sizeof(out), &info, NMEA_TALKER_GN, GPGSA | GPGSV);
+
+    nmea_sat_table_init(&tab_rx);
+    rt_memset(&info_rx, 0, sizeof(info_rx));
+    info_rx.sattab = &tab_rx;
+    nmea_parser_init(&parser);
+    nmea_parse(&parser, out, len, &info_rx);
+    npack = nmea_parse(&parser, out, len, &info_rx);
+    nmea_parser_destroy(&parser);
+
+    nmea_test_sat_count(&tab_rx, NMEA_SYSTEM_GPS, &nview, &nuse);
+    dbg_printf("gen : sattab packs: %d, GPS in view: %d, in use: %d", npack, nview, nuse);
+    nmea_test_sat_count(&tab_rx, NMEA_SYSTEM_GLONASS, &nview, &nuse);
+    dbg_printf(", GLONASS in view: %d, in use: %d (expected 8, 14, 12, 6, 4)\n", nview, nuse);
+
+    /* short buffer keeps every sentence which fits, the last one is dropped */
+    for (it = len - 1; it > 0 && out[it] != '$'; --it)
+        ;
+    dbg_printf("gen : sattab short buffer: %d (expected %d)\n",
+        nmea_generate(out, len - 1, &info, NMEA_TALKER_GN, GPGSA | GPGSV), it);
+
+    /* sentence is not cut by short buffer */
+    nmea_info2gga(&info, NMEA_TALKER_GP, &gga);
+    len = nmea_gen_gga(out, sizeof(out), &gga);
+    dbg_printf("gen : short buffer: %d, exact buffer: %d (expected 0, %d)\n",
+        nmea_gen_gga(out, len - 1, &gga), nmea_gen_gga(out, len, &gga), len);
+}
+
+MSH_CMD_EXPORT(nmea_parse_test_20, nmea sentence generator test);
+
 #endif
 
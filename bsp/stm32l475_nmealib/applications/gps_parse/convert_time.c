@@ -1,40 +1,71 @@
 #include "convert_time.h"
+#include <nmea_parse.h>
 
-struct gps_tm {
-    float tm_msec; /* m_second */
-    int tm_sec; /* second �C [0,59] */
-    int tm_min; /* min - [0,59] */
-    int tm_hour; /* hour - [0,23] */
-    int tm_mday; /* day - [1,31] */
-    int tm_mon; /* month - [0,11] */
-    int tm_year; /* year since 1900 */
-};
+/*
+ * NMEA time is UTC: conversions below use integer calendar arithmetic of
+ * the nmea core instead of struct tm and mktime(), so the local time zone
+ * does not shift results and no float math is done on packed fields.
+ */
+
+#define GPS_WEEK_MS     (7 * 86400000LL)
+
+/*******************************************************
+*function: packed RMC date and time to nmea time
+*******************************************************/
+static void convert_nmea_time(uint32_t ddmmyy, uint32_t hhmmss, nmea_time_t *utc)
+{
+    utc->year = ddmmyy % 100 + 2000 - 1900;
+    utc->mon = (ddmmyy / 100) % 100 - 1;
+    utc->day = ddmmyy / 10000;
+    utc->hour = hhmmss / 10000;
+    utc->min = (hhmmss / 100) % 100;
+    utc->sec = hhmmss % 100;
+    utc->hsec = 0;
+}
+
+/*******************************************************
+*function: convert time
+*  ddmmyy and hhmmss are date and time fields of RMC as integers.
+*return: milliseconds since 1970-01-01 00:00:00 UTC
+*******************************************************/
+int64_t convert_milliseconds(uint32_t ddmmyy, uint32_t hhmmss, uint16_t msec)
+{
+    nmea_time_t utc;
+
+    convert_nmea_time(ddmmyy, hhmmss, &utc);
+    return nmea_time_unix_ms(&utc) + msec;
+}
+
+/*******************************************************
+*function: convert time to GPS time
+*  leap seconds (GPS - UTC) are taken from table of nmea core.
+*return: GPS week, -1 if time is before GPS epoch
+*******************************************************/
+int convert_gps_week(uint32_t ddmmyy, uint32_t hhmmss, uint16_t msec, int32_t *tow_ms)
+{
+    nmea_time_t utc;
+    int64_t gps_ms;
+
+    convert_nmea_time(ddmmyy, hhmmss, &utc);
+    gps_ms = nmea_time_gps_ms(&utc, NMEA_LEAP_SECONDS_AUTO) + msec;
+    if (gps_ms < 0) {
+        return -1;
+    }
+    if (tow_ms != NULL) {
+        *tow_ms = (int32_t)(gps_ms % GPS_WEEK_MS);
+    }
+    return (int)(gps_ms / GPS_WEEK_MS);
+}
 
 /*******************************************************
 *function: convert time
-*return: seconds
+*  yymmdd is date field of RMC (ddmmyy), hhmmss is time field.
+*return: seconds since 1970-01-01 00:00:00 UTC
 *******************************************************/
 double convert_seconds(double yymmdd, double hhmmss)
 {
-    struct gps_tm p_dt;
-    struct tm dt;
-    double result_seconds;
-
-    p_dt.tm_year = ((int)yymmdd) % 100 + 2000 - 1900;
-    p_dt.tm_mon = ((int)(yymmdd / 100)) % 100 - 1;
-    p_dt.tm_mday = ((int)yymmdd) / 10000;
-    p_dt.tm_hour = ((int)hhmmss) / 10000;
-    p_dt.tm_min = ((int)(hhmmss / 100)) % 100;
-    p_dt.tm_sec = ((int)hhmmss) % 100;
-    p_dt.tm_msec = hhmmss - (long)hhmmss;
-
-    dt.tm_year = p_dt.tm_year;
-    dt.tm_mon = p_dt.tm_mon;
-    dt.tm_mday = p_dt.tm_mday;
-    dt.tm_hour = p_dt.tm_hour;
-    dt.tm_min = p_dt.tm_min;
-    dt.tm_sec = p_dt.tm_sec;
-
-    result_seconds = (double)mktime(&dt) + p_dt.tm_msec;
-    return result_seconds;
+    /* fields have at most 3 fraction digits, round once to milliseconds */
+    uint32_t time_ms = (uint32_t)(hhmmss * 1000 + 0.5);
+
+    return convert_milliseconds((uint32_t)yymmdd, time_ms / 1000, time_ms % 1000) / 1000.0;
 }
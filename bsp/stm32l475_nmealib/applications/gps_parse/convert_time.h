@@ -3,9 +3,12 @@
 
 #include <stdio.h>
 #include <string.h>
+#include <stdint.h>
 #include <time.h>
 
 
 double convert_seconds(double yymmdd, double hhmmss);
+int64_t convert_milliseconds(uint32_t ddmmyy, uint32_t hhmmss, uint16_t msec);
+int convert_gps_week(uint32_t ddmmyy, uint32_t hhmmss, uint16_t msec, int32_t *tow_ms);
 
 #endif
@@ -3,8 +3,10 @@
 //#include "ephemeris_timestamp.h"
 //#include "gnss_epo.h"
 #include <rtthread.h>
+#include <nmea_parse.h>
 
 #include <stdlib.h>
+#include <string.h>
 
 #undef LOG_TAG
 #define LOG_TAG "GPS"
@@ -20,28 +22,74 @@ static struct NMEA_PARSE g_nmea_parse = { 0 };
 ************************************************************************************/
 
 
-//uint8_t data_conversion(char *input, char **output, uint8_t section_max_count);
-static double latitude_longitude_conversion(double fData);
+/*
+ * Numbers, coordinates and checksum are decoded by the shared nmea core
+ * (libraries/nmea), this module only keeps its own API and structures.
+ */
 
+/*******************************************************
+*function description:  decimal integer of field, stops at field end
+*
+*return: value, 0 for empty field
+*******************************************************/
+static int span_atoi(const struct NMEA_SPAN *span)
+{
+    return nmea_atoi(span->ptr, span->len, 10);
+}
 
 /*******************************************************
-*function description:  NMEA data separator
+*function description:  decimal number of field, stops at field end
 *
-*return:
+*return: value, 0 for empty field
 *******************************************************/
-static double latitude_longitude_conversion(double fData)
+static double span_atof(const struct NMEA_SPAN *span)
 {
-    double result_val = 0.000000;
-    int32_t i = 0;
-    i = fData / 100;
-    result_val = i + ((fData / 100 - i) * 100) / 60;
-    return result_val;
+    return span->len ? nmea_atof(span->ptr, span->len) : 0;
 }
 
 /*******************************************************
-*function description:  NMEA data separator
+*function description:  coordinate field [d]ddmm.mmmm to degrees
 *
-*return:
+*return: value, 0 for empty or broken field
+*******************************************************/
+static double span_ndeg(const struct NMEA_SPAN *span)
+{
+    return nmea_ndeg_atof(span->ptr, span->len);
+}
+
+/*******************************************************
+*function description:  RMC date (ddmmyy) and time (hhmmss.sss) fields
+*  to Unix time, integer only
+*return: milliseconds, 0 if any field is invalid
+*******************************************************/
+static int64_t span_unix_ms(const struct NMEA_SPAN *date, const struct NMEA_SPAN *time)
+{
+    nmea_time_t utc;
+
+    if (date->len != 6 || nmea_field_time(time->ptr, time->len, &utc) != 0) {
+        return 0;
+    }
+    utc.day = nmea_atoi(date->ptr, 2, 10);
+    utc.mon = nmea_atoi(date->ptr + 2, 2, 10) - 1;
+    utc.year = nmea_atoi(date->ptr + 4, 2, 10) + 2000 - 1900;
+    return nmea_time_unix_ms(&utc);
+}
+
+/*******************************************************
+*function description:  the first character of field
+*
+*return: character, 0 for empty field
+*******************************************************/
+static char span_char(const struct NMEA_SPAN *span)
+{
+    return span->len ? span->ptr[0] : 0;
+}
+
+/*******************************************************
+*function description:  NMEA data separator, old one
+*  output points into input, fields end at next ','.
+*  parse_xxx use data_tokenize instead.
+*return: number of fields - 1
 *******************************************************/
 uint8_t data_conversion(char *input, char **output, uint8_t section_max_count)
 {
@@ -70,6 +118,59 @@ uint8_t data_conversion(char *input, char **output, uint8_t section_max_count)
     return (count - 1);
 }
 
+/*******************************************************
+*function description:  NMEA field splitter, single pass
+*  input is whole sentence from '$', checksum is verified.
+*  span[i] is field i+1 of sentence, without separators.
+*return: number of fields, 0 if sentence is broken
+*  or has no address field (checksum can't be verified)
+*******************************************************/
+uint8_t data_tokenize(const char *input, struct NMEA_SPAN *span, uint8_t section_max_count)
+{
+    const char *ptr, *sep, *star;
+    uint8_t count = 0;
+    int len, pos, crc;
+
+    if (input == RT_NULL || span == RT_NULL) {
+        LOG_E("para invaild\n");
+        return 0;
+    }
+    len = rt_strnlen(input, 2 * MAX_NMEA_PACK_LEN);
+
+    if (*input != '$') {
+        LOG_E("no sentence address, checksum can't be verified\n");
+        return 0;
+    }
+
+    /* XOR of address and fields is folded by words in the core */
+    pos = nmea_scan_sentence(input, len, &crc);
+    if (pos + 2 >= len || input[pos] != '*') {
+        return 0; /* no checksum tail */
+    }
+    star = input + pos;
+    if ((crc & 0xFF) != nmea_atoi(star + 1, 2, 16)) {
+        LOG_D("checksum error\n");
+        return 0;
+    }
+    sep = (const char *)memchr(input, GPS_SEPARATOR, pos);
+    if (sep == RT_NULL || star - sep > MAX_NMEA_PACK_LEN) {
+        return 0;
+    }
+
+    for (ptr = sep + 1;; ptr = sep + 1) {
+        sep = (const char *)memchr(ptr, GPS_SEPARATOR, star - ptr);
+        if (count < section_max_count) {
+            span[count].ptr = ptr;
+            span[count].len = (sep ? sep : star) - ptr;
+            count++;
+        }
+        if (sep == RT_NULL) {
+            break;
+        }
+    }
+    return count;
+}
+
 /* GGA example:
  * $GNGGA,    030432.000,  3112.4500,    N,     12135.1158,    E,
  * <0-$head>,<1-utc_time>,<2-latitude>,<3-N/S>,<4-longtitude>,<5-E/W>,
@@ -78,51 +179,45 @@ uint8_t data_conversion(char *input, char **output, uint8_t section_max_count)
  */
 /*******************************************************
 *function description: parse GGA
-*
+*  input is whole sentence from '$'
 *return: FALSE:parse fail,TRUE:parse success
 *******************************************************/
 bool parse_gga(uint8_t *input, struct NMEA_GGA *pdat)
 {
-    char *ptr_section[GGA_SECTION_MAX] = { 0 };
-    float hdop = 0.00;
-    float altitude = 0.00;
-    double temp_data;
+    struct NMEA_SPAN section[GGA_SECTION_MAX] = { 0 };
 
     if (input == RT_NULL || pdat == NULL) {
         LOG_E("gga para fail\n");
         return false;
     }
-    uint8_t count = data_conversion((char *)input, ptr_section, GGA_SECTION_MAX);
+    uint8_t count = data_tokenize((const char *)input, section, GGA_SECTION_MAX);
 
-    if (PARSE_GGA_MESSAGE_MAX_LEN > count) {
+    if (PARSE_GGA_MESSAGE_MAX_LEN >= count) {
         LOG_E("gga count invalid\n");
         return false;
     }
 
-    temp_data = atof((char *)ptr_section[0]);
-    pdat->utc_time = temp_data;
+    pdat->utc_time = span_atof(&section[0]);
 
-    temp_data = atof((char *)ptr_section[1]);
-    pdat->Latitude = latitude_longitude_conversion(temp_data);
-    if (*ptr_section[2] == 'N')
+    pdat->Latitude = span_ndeg(&section[1]);
+    if (span_char(&section[2]) == 'N')
         pdat->north_south = 0;
-    else if (*ptr_section[2] == 'S')
+    else if (span_char(&section[2]) == 'S')
         pdat->north_south = 1;
     else
         pdat->north_south = -1;
 
-    temp_data = atof(ptr_section[3]);
-    pdat->Longitude = latitude_longitude_conversion(temp_data);
-    if (*ptr_section[4] == 'E')
+    pdat->Longitude = span_ndeg(&section[3]);
+    if (span_char(&section[4]) == 'E')
         pdat->east_west = 0;
-    else if (*ptr_section[4] == 'W')
+    else if (span_char(&section[4]) == 'W')
         pdat->east_west = 1;
     else
         pdat->east_west = -1;
 
-    pdat->sat_in_view = atoi(ptr_section[6]);
-    pdat->hdop = atof(ptr_section[7]);
-    pdat->altitude = atof(ptr_section[8]);
+    pdat->sat_in_view = span_atoi(&section[6]);
+    pdat->hdop = span_atof(&section[7]);
+    pdat->altitude = span_atof(&section[8]);
     return true;
 }
 /* RMC example:
@@ -133,62 +228,53 @@ bool parse_gga(uint8_t *input, struct NMEA_GGA *pdat)
  */
 /*******************************************************
 *function description: parse RMC
-*
+*  input is whole sentence from '$'
 *return: FALSE:parse fail,TRUE:parse success
 *******************************************************/
 bool parse_rmc(uint8_t *input, struct NMEA_RMC *pdat)
 {
-    double temp_data;
-    float azimuth = 0.00;
-    char *ptr_section[RMC_SECTION_MAX] = { 0 };
+    struct NMEA_SPAN section[RMC_SECTION_MAX] = { 0 };
 
     if (input == RT_NULL || pdat == NULL) {
         LOG_E("rmc input invalid\n");
         return false;
     }
-    uint8_t count = data_conversion((char *)input, ptr_section, RMC_SECTION_MAX);
+    uint8_t count = data_tokenize((const char *)input, section, RMC_SECTION_MAX);
 
-    if (count < PARSE_RMC_MESSAGE_MAX_LEN) {
+    if (count <= PARSE_RMC_MESSAGE_MAX_LEN) {
         LOG_E("rmc count invalid\n");
         pdat->position_status = -1;
         return false;
     }
 
-    temp_data = atof((char *)ptr_section[0]);
-    pdat->utc_time = temp_data;
-    if (*ptr_section[1] == 'V')
+    pdat->utc_time = span_atof(&section[0]);
+    if (span_char(&section[1]) == 'V')
         pdat->position_status = 0;
-    else if (*ptr_section[1] == 'A')
+    else if (span_char(&section[1]) == 'A')
         pdat->position_status = 1;
     else
         pdat->position_status = -1;
 
-    temp_data = atof((char *)ptr_section[2]);
-    pdat->Latitude = latitude_longitude_conversion(temp_data);
-    if (*ptr_section[3] == 'N')
+    pdat->Latitude = span_ndeg(&section[2]);
+    if (span_char(&section[3]) == 'N')
         pdat->north_south = 0;
-    else if (*ptr_section[3] == 'S')
+    else if (span_char(&section[3]) == 'S')
         pdat->north_south = 1;
     else
         pdat->north_south = -1;
 
-    temp_data = atof(ptr_section[4]);
-    pdat->Longitude = latitude_longitude_conversion(temp_data);
-    if (*ptr_section[5] == 'E')
+    pdat->Longitude = span_ndeg(&section[4]);
+    if (span_char(&section[5]) == 'E')
         pdat->east_west = 0;
-    else if (*ptr_section[5] == 'W')
+    else if (span_char(&section[5]) == 'W')
         pdat->east_west = 1;
     else
         pdat->east_west = -1;
 
-    temp_data = atof(ptr_section[6]);
-    pdat->speed = temp_data;
-
-    azimuth = atof(ptr_section[7]);
-    pdat->azimuth = azimuth;
-
-    temp_data = atof((char *)ptr_section[8]);
-    pdat->utc_date = temp_data;
+    pdat->speed = span_atof(&section[6]);
+    pdat->azimuth = span_atof(&section[7]);
+    pdat->utc_date = span_atof(&section[8]);
+    pdat->utc_ms = span_unix_ms(&section[8], &section[0]);
 
     return true;
 }
@@ -202,107 +288,101 @@ bool parse_rmc(uint8_t *input, struct NMEA_RMC *pdat)
  */
 /*******************************************************
 *function description: parse GSV
-*
+*  input is whole sentence from '$'
 *return: FALSE:parse fail,TRUE:parse success
 *******************************************************/
 bool parse_gsv(uint8_t *input, struct NMEA_GSV *pview)
 {
-    char *ptr_section[GSV_SECTION_MAX] = { 0 };
-    int prn; /*prn*/
-    int elevation; /*elevation in degrees*/
-    int azimuth; /*azimuth in degrees to true*/
-    int cnr; /*cnr in dB(dB)*/
+    struct NMEA_SPAN section[GSV_SECTION_MAX] = { 0 };
     uint8_t count = 0x00, i = 0, total_no = 0, cur_no = 0, cur_index = 0;
+    uint16_t bit;
 
     if (input == RT_NULL || pview == NULL) {
         LOG_E("gsv input NULL\n");
         return false;
     }
 
-    count = data_conversion((char *)input, ptr_section, GSV_SECTION_MAX);
-    if (count < PARSE_GSV_MESSAGE_MAX_LEN) {
+    count = data_tokenize((const char *)input, section, GSV_SECTION_MAX);
+    if (count <= PARSE_GSV_MESSAGE_MAX_LEN) {
         /*LOG_E("gps_inter_parse_gsv count is small\n");*/
         return false;
     }
-    if (ptr_section[0] != NULL) {
-        total_no = atoi(ptr_section[0]); /*total gsv msg*/
-    } else {
-        LOG_E("gsv total_no data invalid\n");
-        return false;
-    }
-    if (ptr_section[1] != NULL) {
-        cur_no = atoi(ptr_section[1]); /*current gsv msg no.*/
-    } else {
-        LOG_E("gsv cur_no data invalid\n");
-        return false;
-    }
+    total_no = span_atoi(&section[0]); /*total gsv msg*/
+    cur_no = span_atoi(&section[1]); /*current gsv msg no.*/
     if (cur_no < 1) {
         LOG_E("currect number is invalid\n");
         return false;
     }
-    cur_index = (cur_no - 1) * 4;
-    if (cur_no == 1) {
-        rt_memset(pview, 0x00, sizeof(struct NMEA_GSV));
-    }
-
-    /*update private parse data*/
-    if (ptr_section[2] != NULL) {
-        /* gps_private_parse_data.sat_in_view = atoi(ptr_section[2]); */
-        pview->sates_in_view = atoi(ptr_section[2]);
-    } else {
-        LOG_E("gsv sat_in_view null\n");
+    if (total_no < cur_no) {
+        LOG_E("gsv total_no >= cur_no\n");
+        return false;
     }
+    cur_index = (cur_no - 1) * 4;
+    bit = (cur_no <= 16) ? (uint16_t)(1 << (cur_no - 1)) : 0;
 
-    for (i = 3; i < count && cur_index < GPS_NMEA_MAX_SVVIEW;) {
-        if (ptr_section[i] != NULL) {
-            prn = atoi(ptr_section[i]);
-        } else {
-            prn = 0;
-        }
-        if (ptr_section[i + 1] != NULL) {
-            elevation = atoi(ptr_section[i + 1]);
-        } else {
-            elevation = 0;
-        }
-        if (ptr_section[i + 2] != NULL) {
-            azimuth = atoi(ptr_section[i + 2]);
-        } else {
-            azimuth = 0;
-        }
-        if (ptr_section[i + 3] != NULL) {
-            cnr = atoi(ptr_section[i + 3]);
-        } else {
-            cnr = 0;
+    /* msg 1, msg received already or other cycle size starts new cycle,
+     * so data of lost msg is never mixed from the cycle before */
+    if (cur_no == 1 || (pview->msg_mask & bit) || total_no != pview->msg_total) {
+        if (pview->msg_mask && !gsv_complete(pview)) {
+            pview->incomplete++;
         }
+        rt_memset(pview->rsv, 0x00, sizeof(pview->rsv));
+        pview->msg_total = total_no;
+        pview->msg_mask = 0;
+    }
 
-        pview->rsv[cur_index].prn = prn;
-        pview->rsv[cur_index].elevation = elevation;
-        pview->rsv[cur_index].azimuth = azimuth;
-        pview->rsv[cur_index].cnr = cnr;
+    /*update private parse data*/
+    pview->sates_in_view = span_atoi(&section[2]);
+
+    /* the last field is signal ID of NMEA 4.10 or cnr of the last satellite,
+     * fields after count are empty spans */
+    for (i = 3; i < count - 1 && cur_index < GPS_NMEA_MAX_SVVIEW; i += 4) {
+        pview->rsv[cur_index].prn = span_atoi(&section[i]);
+        pview->rsv[cur_index].elevation = span_atoi(&section[i + 1]);
+        pview->rsv[cur_index].azimuth = span_atoi(&section[i + 2]);
+        pview->rsv[cur_index].cnr = span_atoi(&section[i + 3]);
         cur_index++;
-        i += 4;
-
-        prn = 0;
-        elevation = 0;
-        azimuth = 0;
-        cnr = 0;
     }
 
-    if (total_no < cur_no) {
-        LOG_E("gsv total_no >= cur_no\n");
+    pview->msg_mask |= bit;
+    return true;
+}
+
+/*******************************************************
+*function description: check that all gsv msg of cycle were parsed
+*  since msg 1, sky view is complete then
+*return: FALSE:msg lost or cycle in progress,TRUE:complete
+*******************************************************/
+bool gsv_complete(const struct NMEA_GSV *pview)
+{
+    if (pview == NULL || pview->msg_total == 0 || pview->msg_total > 16) {
         return false;
     }
-    return true;
+    return pview->msg_mask == (uint16_t)((1UL << pview->msg_total) - 1);
 }
 
 bool parse_epe(uint8_t *input, struct NMEA_EPE *pdat)
 {
+    struct NMEA_SPAN section[EPE_SECTION_MAX] = { 0 };
+    const char *tail;
+
     if (input == RT_NULL || pdat == NULL) {
         LOG_E("gnepe input NULL\n");
         return false;
     }
 
-    sscanf((char *)input, "$GNEPE,%f,%f*%X", &pdat->hacc, &pdat->vacc, &pdat->checksum);
+    /* $GNEPE,hacc,vacc*CS */
+    if (data_tokenize((const char *)input, section, EPE_SECTION_MAX) < EPE_SECTION_MAX) {
+        LOG_E("gnepe count invalid\n");
+        return false;
+    }
+    pdat->hacc = span_atof(&section[0]);
+    pdat->vacc = span_atof(&section[1]);
+
+    tail = section[1].ptr + section[1].len;
+    if (*tail == '*') {
+        pdat->checksum = nmea_atoi(tail + 1, 2, 16);
+    }
 
     return true;
 }
@@ -316,25 +396,60 @@ void gps_ospi_parse_nmea(void)
     char *gsv = "$GPGSV,1,1,01,01,,,41,1*61\r\n";
     char *gga = "$GNGGA,014423.00,2930.34347,N,10634.36892,E,2,12,1.00,245.4,M,-26.5,M,,0000*61\r\n";
 
-    rmc += 3;
-    if (memcmp(rmc, "RMC", 3) == 0) {
-        rmc += 3;
+    if (memcmp(rmc + 3, "RMC", 3) == 0) {
         parse_rmc((uint8_t *)rmc, &g_nmea_parse.rmc);
         rt_kprintf("Latitude: %lf, Longitude: %lf\r\n", g_nmea_parse.rmc.Latitude, g_nmea_parse.rmc.Longitude);
     }
 
-    gsv += 3;
-    if (memcmp(gsv, "GSV", 3) == 0) {
-        gsv += 3;
+    if (memcmp(gsv + 3, "GSV", 3) == 0) {
         parse_gsv((uint8_t *)gsv, &g_nmea_parse.gsv);
     }
 
-    gga += 3;
-    if (memcmp(gga, "GGA", 3) == 0) {
-        gga += 3;
+    if (memcmp(gga + 3, "GGA", 3) == 0) {
         parse_gga((uint8_t *)gga, &g_nmea_parse.gga);
         rt_kprintf("Latitude: %lf, Longitude: %lf\r\n", g_nmea_parse.gga.Latitude, g_nmea_parse.gga.Longitude);
     }
 }
 MSH_CMD_EXPORT(gps_ospi_parse_nmea, parse gps nmea data);
+
+/*gps nmea field split benchmark: data_conversion + atof vs data_tokenize*/
+void gps_parse_bench(int argc, char **argv)
+{
+    static char *sentence[] = {
+        "$GNRMC,014419.00,A,2930.34343,N,10634.36893,E,0.000,354.29,020221,2.60,W,D*37\r\n",
+        "$GPGSV,1,1,01,01,,,41,1*61\r\n",
+        "$GNGGA,014423.00,2930.34347,N,10634.36892,E,2,12,1.00,245.4,M,-26.5,M,,0000*61\r\n",
+    };
+    int loops = (argc > 1) ? atoi(argv[1]) : 10000;
+    char *ptr_section[GSV_SECTION_MAX];
+    struct NMEA_SPAN section[GSV_SECTION_MAX];
+    volatile double sum_old = 0, sum_new = 0;
+    rt_tick_t tick_old, tick_new;
+    int loop, it, i, count;
+
+    tick_old = rt_tick_get();
+    for (loop = 0; loop < loops; ++loop) {
+        for (it = 0; it < 3; ++it) {
+            count = data_conversion(sentence[it] + 6, ptr_section, GSV_SECTION_MAX);
+            for (i = 0; i <= count; ++i)
+                sum_old += atof(ptr_section[i]);
+        }
+    }
+    tick_old = rt_tick_get() - tick_old;
+
+    tick_new = rt_tick_get();
+    for (loop = 0; loop < loops; ++loop) {
+        for (it = 0; it < 3; ++it) {
+            count = data_tokenize(sentence[it], section, GSV_SECTION_MAX);
+            for (i = 0; i < count; ++i)
+                sum_new += span_atof(&section[i]);
+        }
+    }
+    tick_new = rt_tick_get() - tick_new;
+
+    rt_kprintf("data_conversion: %d ms, data_tokenize (with checksum): %d ms, sums %s\r\n",
+        (int)(tick_old * 1000 / RT_TICK_PER_SECOND), (int)(tick_new * 1000 / RT_TICK_PER_SECOND),
+        (sum_old == sum_new) ? "match" : "differ");
+}
+MSH_CMD_EXPORT(gps_parse_bench, benchmark gps nmea field split: [loops]);
 #endif
@@ -12,6 +12,7 @@
 #define GGA_SECTION_MAX           14
 #define RMC_SECTION_MAX           12
 #define GSV_SECTION_MAX           19
+#define EPE_SECTION_MAX           2
 #define GPS_NMEA_MAX_SVVIEW       40 /*12*/
 #define GLO_SECTION_MAX           37
 #define MDI_GPS_NMEA_MAX_SVVIEW   40 /*12*/
@@ -21,6 +22,12 @@
 #define PARSE_GSV_MESSAGE_MAX_LEN 0x07
 #define PARSE_RMC_MESSAGE_MAX_LEN 0x09
 
+/* field of sentence, not terminated, points into input */
+struct NMEA_SPAN {
+    const char *ptr;
+    uint8_t len;
+};
+
 struct NMEA_GGA {
     double utc_time;
     float Latitude; /*wei du*/
@@ -43,6 +50,7 @@ struct NMEA_RMC {
     double speed;
     float azimuth;          /*yaw*/
     double utc_date;        /*DDMMYY*/
+    int64_t utc_ms;         /*Unix time in milliseconds, 0 if date or time is invalid*/
 };
 
 struct NMEA_EPE {
@@ -59,6 +67,9 @@ struct NMEA_GSV_SATELITES {
 };
 struct NMEA_GSV {
     int16_t sates_in_view; /*satellites in view*/
+    uint8_t msg_total; /*number of gsv msg in cycle*/
+    uint16_t msg_mask; /*received gsv msg, bit 0 - msg 1*/
+    uint16_t incomplete; /*cycles dropped before all msg were received*/
     struct NMEA_GSV_SATELITES rsv[MDI_GPS_NMEA_MAX_SVVIEW]; /*Satellite attributes*/
 };
 
@@ -78,9 +89,11 @@ struct NMEA_PARSE {
 
 void gps_clear_private_data(void);
 uint8_t data_conversion(char *input, char **output, uint8_t section_max_count);
+uint8_t data_tokenize(const char *input, struct NMEA_SPAN *span, uint8_t section_max_count);
 
 bool parse_gga(uint8_t *input, struct NMEA_GGA *pdat);
 bool parse_rmc(uint8_t *input, struct NMEA_RMC *pdat);
 bool parse_gsv(uint8_t *input, struct NMEA_GSV *pdat);
 bool parse_epe(uint8_t *input, struct NMEA_EPE *pdat);
+bool gsv_complete(const struct NMEA_GSV *pview);
 #endif
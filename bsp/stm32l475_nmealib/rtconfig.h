@@ -199,6 +199,20 @@
 #define SOC_FAMILY_STM32
 #define SOC_SERIES_STM32L4
 
+/* NMEA parser */
+
+#define NMEA_USING_PACK_POOL
+#define NMEA_PACK_POOL_SIZE 16
+#define NMEA_SAT_TABLE_SIZE 64
+#define NMEA_GSV_MAX_SAT 32
+#define NMEA_GSV_MAX_STREAMS 8
+#define NMEA_PROP_MAX_HANDLERS 8
+#define NMEA_USING_UBX
+#define NMEA_UBX_MAX_PAYLOAD 512
+#define NMEA_USING_RTCM
+#define NMEA_RTCM_MAX_PAYLOAD 1023
+#define NMEA_PARALLEL_MAX_THREADS 1
+
 /* Hardware Drivers Config */
 
 #define SOC_STM32L475VE
@@ -0,0 +1,171 @@
+#include <nmea_parse.h>
+#include <string.h>
+
+/*
+ * Batch parse: sentences are decoded straight from the caller buffer
+ * (mmap'd log file for example), packets live on the stack, epoch
+ * assembler writes one record by navigation cycle.
+ */
+
+/**
+ * \brief Write fix of cycle into output arrays.
+ */
+static void nmea_batch_record(const nmea_info_t *fix, void *user_data)
+{
+    nmea_batch_t *batch = (nmea_batch_t *)user_data;
+    int rec = batch->count;
+
+    NMEA_ASSERT(rec < batch->capacity);
+
+    if (batch->offset)
+        batch->offset[rec] = batch->rec_offset;
+    if (batch->utc_ms)
+        batch->utc_ms[rec] = ((fix->utc.hour * 60 + fix->utc.min) * 60 + fix->utc.sec) * 1000 + fix->utc.hsec * 10;
+    if (batch->date)
+        batch->date[rec] = (fix->smask & (GPRMC | GPZDA)) ?
+            (fix->utc.year + 1900) * 10000 + (fix->utc.mon + 1) * 100 + fix->utc.day : 0;
+    if (batch->lat)
+        batch->lat[rec] = fix->lat;
+    if (batch->lon)
+        batch->lon[rec] = fix->lon;
+    if (batch->alt)
+        batch->alt[rec] = fix->elv;
+    if (batch->speed)
+        batch->speed[rec] = fix->speed;
+    if (batch->course)
+        batch->course[rec] = fix->direction;
+    if (batch->hdop)
+        batch->hdop[rec] = fix->HDOP;
+    if (batch->sig)
+        batch->sig[rec] = (rt_uint8_t)fix->sig;
+    if (batch->fix)
+        batch->fix[rec] = (rt_uint8_t)fix->fix;
+
+    batch->count++;
+
+    /* cycle ended by time change, the sentence being added starts next one */
+    batch->rec_offset = batch->sen_offset;
+}
+
+/**
+ * \brief Initialize batch parse, output arrays are to be set after it.
+ * @param batch a pointer of batch.
+ * @param capacity size of every output array, at least 2.
+ * @param last_type packet type which ends cycle (NMEA_PACK_TYPE), GPNON - by time change.
+ * @see nmea_epoch_init
+ */
+void nmea_batch_init(nmea_batch_t *batch, int capacity, int last_type)
+{
+    NMEA_ASSERT(batch && capacity >= 2);
+
+    rt_memset(batch, 0, sizeof(nmea_batch_t));
+    batch->capacity = capacity;
+    nmea_epoch_init(&batch->epoch, last_type, nmea_batch_record, batch);
+}
+
+/**
+ * \brief Start new portion of output, cycle in progress is kept.
+ * @param batch a pointer of batch.
+ */
+void nmea_batch_reset(nmea_batch_t *batch)
+{
+    NMEA_ASSERT(batch);
+
+    batch->count = 0;
+    batch->err_count = 0;
+}
+
+/**
+ * \brief Remember broken sentence.
+ */
+static void nmea_batch_error(nmea_batch_t *batch, rt_uint32_t offset)
+{
+    if (batch->err_offset && batch->err_count < batch->err_capacity)
+        batch->err_offset[batch->err_count] = offset;
+    batch->err_count++;
+}
+
+/**
+ * \brief Parse buffer in place, without copy and heap allocation.
+ * Parse stops when there is no room for records of the next sentence
+ * (one sentence may end two cycles) or at incomplete sentence at the end
+ * of buffer. Continue with the rest of input after nmea_batch_reset().
+ * @param batch a pointer of batch.
+ * @param buff a constant character pointer of input.
+ * @param buff_sz input size.
+ * @return Number of bytes was processed
+ */
+int nmea_parse_batch(nmea_batch_t *batch, const char *buff, int buff_sz)
+{
+    const char *pos = buff, *end_buff = buff + buff_sz;
+    rt_uint32_t offset;
+    nmea_pack_t pack;
+    int ptype, nread, crc;
+
+    NMEA_ASSERT(batch && buff);
+
+    while (pos < end_buff && batch->capacity - batch->count >= 2)
+    {
+        pos = (const char *)memchr(pos, '$', end_buff - pos);
+        if (!pos)
+        {
+            pos = end_buff;
+            break;
+        }
+
+        offset = batch->base + (rt_uint32_t)(pos - buff);
+        nread = nmea_find_tail(pos, (int)(end_buff - pos), &crc);
+
+        if (!nread)
+        {
+            /* sentence is cut by end of buffer, wait for the rest */
+            if (!memchr(pos, '\n', end_buff - pos))
+                break;
+            nmea_batch_error(batch, offset);
+            ++pos;
+            continue;
+        }
+
+        if (crc < 0)
+        {
+            nmea_batch_error(batch, offset);
+            pos += nread;
+            continue;
+        }
+
+        ptype = nmea_pack_type(pos + 1, nread - 1);
+        if (GPNON != ptype)
+        {
+            if (!nmea_pack_decode(ptype, pos, nread, &pack))
+                nmea_batch_error(batch, offset);
+            else
+            {
+                if (!batch->epoch.fix.smask)
+                    batch->rec_offset = offset;
+                batch->sen_offset = offset;
+                nmea_epoch_input(&batch->epoch, ptype, &pack);
+            }
+        }
+
+        pos += nread;
+    }
+
+    batch->base += (rt_uint32_t)(pos - buff);
+
+    return (int)(pos - buff);
+}
+
+/**
+ * \brief Write record of the last cycle at the end of input.
+ * @param batch a pointer of batch.
+ * @return 1 - record was written, 0 - no cycle in progress or no room
+ */
+int nmea_batch_flush(nmea_batch_t *batch)
+{
+    NMEA_ASSERT(batch);
+
+    if (batch->count >= batch->capacity)
+        return 0;
+
+    return nmea_epoch_flush(&batch->epoch);
+}
@@ -0,0 +1,113 @@
+#include <nmea_parse.h>
+
+/**
+ * \brief Initialize epoch assembler.
+ * @param epoch a pointer of assembler.
+ * @param last_type packet type which ends cycle (NMEA_PACK_TYPE), GPNON - end cycle by time change.
+ * @param handler callback of consolidated fix.
+ * @param user_data user data passed to handler.
+ */
+void nmea_epoch_init(nmea_epoch_t *epoch, int last_type, nmea_epoch_handler_t handler, void *user_data)
+{
+    NMEA_ASSERT(epoch);
+
+    rt_memset(epoch, 0, sizeof(nmea_epoch_t));
+    epoch->utc_key = -1;
+    epoch->last_type = last_type;
+    epoch->handler = handler;
+    epoch->user_data = user_data;
+}
+
+/**
+ * \brief Publish fix of current cycle, if any packet was added to it.
+ * @return 1 - fix was published or 0 - cycle is empty
+ */
+int nmea_epoch_flush(nmea_epoch_t *epoch)
+{
+    NMEA_ASSERT(epoch);
+
+    if (!epoch->fix.smask)
+        return 0;
+
+    epoch->count++;
+    if (epoch->handler)
+        epoch->handler(&epoch->fix, epoch->user_data);
+
+    /* values stay as base of next cycle, mask tells what it brings */
+    epoch->fix.smask = 0;
+    epoch->utc_key = -1;
+
+    return 1;
+}
+
+/**
+ * \brief UTC time of packet in hundredths of second.
+ * @param ptype packet type (NMEA_PACK_TYPE).
+ * @param pack a pointer of packet structure.
+ * @return Time or -1 if packet has no time
+ */
+int nmea_epoch_utc(int ptype, void *pack)
+{
+    const nmea_time_t *utc;
+
+    switch (ptype)
+    {
+    case GPGGA:
+        utc = &((nmea_gga_t *)pack)->utc;
+        break;
+    case GPRMC:
+        utc = &((nmea_rmc_t *)pack)->utc;
+        break;
+    case GPGNS:
+        utc = &((nmea_gns_t *)pack)->utc;
+        break;
+    case GPGLL:
+        utc = &((nmea_gll_t *)pack)->utc;
+        break;
+    default:
+        return -1;
+    };
+
+    return ((utc->hour * 60 + utc->min) * 60 + utc->sec) * 100 + utc->hsec;
+}
+
+/**
+ * \brief Add packet to current cycle.
+ * @param epoch a pointer of assembler.
+ * @param ptype packet type (NMEA_PACK_TYPE).
+ * @param pack a pointer of packet structure.
+ * @return Number of fixes was published (0, 1 or 2)
+ */
+int nmea_epoch_input(nmea_epoch_t *epoch, int ptype, void *pack)
+{
+    int utc_key, npub = 0;
+
+    NMEA_ASSERT(epoch && pack);
+
+    utc_key = nmea_epoch_utc(ptype, pack);
+    if (utc_key >= 0)
+    {
+        /* packet of next cycle, previous one has not seen its last packet */
+        if (epoch->utc_key >= 0 && utc_key != epoch->utc_key)
+            npub += nmea_epoch_flush(epoch);
+        epoch->utc_key = utc_key;
+    }
+
+    nmea_pack_info(ptype, pack, &epoch->fix);
+
+    if (ptype == epoch->last_type &&
+        (GPGSV != ptype || ((nmea_gsv_t *)pack)->pack_index >= ((nmea_gsv_t *)pack)->pack_count))
+        npub += nmea_epoch_flush(epoch);
+
+    return npub;
+}
+
+/**
+ * \brief Packet handler of stream mode, feeds epoch assembler.
+ * @param user_data a pointer of assembler (nmea_epoch_t).
+ * @see nmea_parser_set_handler
+ */
+void nmea_epoch_pack_handler(int ptype, void *pack, void *user_data)
+{
+    nmea_epoch_input((nmea_epoch_t *)user_data, ptype, pack);
+}
@@ -0,0 +1,83 @@
+#include <nmea_parse.h>
+
+/**
+ * \brief Initialize fix publication.
+ * @param pub a pointer of publication.
+ */
+void nmea_fix_pub_init(nmea_fix_pub_t *pub)
+{
+    NMEA_ASSERT(pub);
+
+    rt_memset(pub, 0, sizeof(nmea_fix_pub_t));
+}
+
+/**
+ * \brief Publish new fix, must be called by single writer.
+ * @param pub a pointer of publication.
+ * @param fix a pointer of fix to copy.
+ */
+void nmea_fix_publish(nmea_fix_pub_t *pub, const nmea_info_t *fix)
+{
+    rt_uint32_t seq;
+
+    NMEA_ASSERT(pub && fix);
+
+    seq = pub->seq + 1;
+    rt_memcpy(&pub->fix[seq & 1], fix, sizeof(nmea_info_t));
+
+    /* copy must be complete before readers see new sequence */
+    NMEA_MEMORY_BARRIER();
+    pub->seq = seq;
+    /* and new sequence must be seen before the next copy overwrites the
+     * slot which readers of the previous sequence may still be copying */
+    NMEA_MEMORY_BARRIER();
+}
+
+/**
+ * \brief Take consistent copy of the latest fix.
+ * Copy is consistent if writer did not complete one more publication
+ * during it, which started to overwrite the copy being read.
+ * Reader does not write publication, so readers never race each other.
+ * @param pub a pointer of publication.
+ * @param fix a pointer of structure for copy.
+ * @param seq a pointer for return sequence number of the fix, may be RT_NULL.
+ * @return 1 - success, 0 - nothing was published or -1 - writer is too fast, try later
+ */
+int nmea_fix_read(const nmea_fix_pub_t *pub, nmea_info_t *fix, rt_uint32_t *seq)
+{
+    rt_uint32_t seq_beg, seq_end;
+    int retry;
+
+    NMEA_ASSERT(pub && fix);
+
+    for (retry = 0; retry < NMEA_FIX_READ_RETRY; ++retry)
+    {
+        seq_beg = pub->seq;
+        if (!seq_beg)
+            return 0;
+
+        NMEA_MEMORY_BARRIER();
+        rt_memcpy(fix, &pub->fix[seq_beg & 1], sizeof(nmea_info_t));
+        NMEA_MEMORY_BARRIER();
+
+        seq_end = pub->seq;
+        if (seq_end == seq_beg)
+        {
+            if (seq)
+                *seq = seq_beg;
+            return 1;
+        }
+    }
+
+    return -1;
+}
+
+/**
+ * \brief Fix handler of epoch assembler, publishes every fix.
+ * @param user_data a pointer of publication (nmea_fix_pub_t).
+ * @see nmea_epoch_init
+ */
+void nmea_fix_pub_handler(const nmea_info_t *fix, void *user_data)
+{
+    nmea_fix_publish((nmea_fix_pub_t *)user_data, fix);
+}
@@ -0,0 +1,811 @@
+#include <nmea_parse.h>
+
+/*
+ * Generator of NMEA sentences: fields are formatted by integer code straight
+ * into output buffer and checksum is accumulated while characters are
+ * written, so there is no vsnprintf() and no second pass over sentence.
+ * Every field is at most 12 characters, no sentence is longer than
+ * NMEA_MAX_SENTENCE.
+ */
+
+#define NMEA_GEN_MIN_SCALE      (10000)   /**< Minutes of coordinate are written with 4 decimals */
+#define NMEA_GEN_ROUND_MAX      (2000000000.0)
+#define NMEA_GEN_MAX_SIGNAL     (15)      /**< Signal IDs of satellites table are 0..15 */
+
+/** Output of sentence being generated */
+typedef struct _nmea_gen_out
+{
+    char       *start;
+    char       *ptr;
+    rt_uint8_t  crc;
+} nmea_gen_out_t;
+
+static const char nmea_gen_hex[] = "0123456789ABCDEF";
+
+static const char nmea_gen_pairs[] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+/** Talker by NMEA_TALKER */
+static const char nmea_gen_talker_tab[][2] =
+{
+    { 'G', 'P' }, { 'G', 'P' }, { 'G', 'L' }, { 'G', 'A' },
+    { 'G', 'B' }, { 'B', 'D' }, { 'G', 'Q' }, { 'G', 'N' }
+};
+
+/** Talker of GSV by GNSS system (NMEA_SYSTEM) */
+static const char nmea_gen_system_tab[][2] =
+{
+    { 'G', 'N' }, { 'G', 'P' }, { 'G', 'L' }, { 'G', 'A' },
+    { 'G', 'B' }, { 'G', 'Q' }, { 'G', 'I' }
+};
+
+rt_inline void nmea_gen_char(nmea_gen_out_t *out, char ch)
+{
+    *out->ptr++ = ch;
+    out->crc ^= (rt_uint8_t)ch;
+}
+
+rt_inline void nmea_gen_comma(nmea_gen_out_t *out)
+{
+    nmea_gen_char(out, ',');
+}
+
+/**
+ * \brief Write field of one character, empty field if it is zero.
+ */
+rt_inline void nmea_gen_char_field(nmea_gen_out_t *out, char ch)
+{
+    nmea_gen_comma(out);
+    if (ch)
+        nmea_gen_char(out, ch);
+}
+
+/**
+ * \brief Write two decimal digits of value, 0..99.
+ */
+rt_inline void nmea_gen_digits2(nmea_gen_out_t *out, int val)
+{
+    nmea_gen_char(out, nmea_gen_pairs[val * 2]);
+    nmea_gen_char(out, nmea_gen_pairs[val * 2 + 1]);
+}
+
+/**
+ * \brief Write unsigned decimal, padded by zeros to width.
+ */
+static void nmea_gen_uint(nmea_gen_out_t *out, rt_uint32_t val, int width)
+{
+    char tmp[10];
+    int len = 0;
+
+    while (val >= 100)
+    {
+        rt_uint32_t pair = val % 100;
+
+        val /= 100;
+        tmp[len++] = nmea_gen_pairs[pair * 2 + 1];
+        tmp[len++] = nmea_gen_pairs[pair * 2];
+    }
+    tmp[len++] = (char)('0' + val % 10);
+    if (val >= 10)
+        tmp[len++] = (char)('0' + val / 10);
+
+    for (; width > len; --width)
+        nmea_gen_char(out, '0');
+    while (len)
+        nmea_gen_char(out, tmp[--len]);
+}
+
+/**
+ * \brief Write signed decimal, magnitude padded by zeros to width.
+ */
+static void nmea_gen_int(nmea_gen_out_t *out, rt_int32_t val, int width)
+{
+    if (val < 0)
+    {
+        nmea_gen_char(out, '-');
+        nmea_gen_uint(out, 0u - (rt_uint32_t)val, width);
+    }
+    else
+        nmea_gen_uint(out, (rt_uint32_t)val, width);
+}
+
+/**
+ * \brief Write value with one decimal, val is in tenths.
+ */
+static void nmea_gen_tenths(nmea_gen_out_t *out, rt_int32_t val)
+{
+    rt_uint32_t mag = (val < 0) ? 0u - (rt_uint32_t)val : (rt_uint32_t)val;
+
+    if (val < 0)
+        nmea_gen_char(out, '-');
+    nmea_gen_uint(out, mag / 10, 1);
+    nmea_gen_char(out, '.');
+    nmea_gen_char(out, (char)('0' + mag % 10));
+}
+
+#ifdef NMEA_USING_FIXED_POINT
+/**
+ * \brief Divide with rounding half away from zero.
+ */
+rt_inline rt_int32_t nmea_gen_div_round(rt_int32_t val, rt_int32_t div)
+{
+    return (val < 0) ? -((-val + div / 2) / div) : (val + div / 2) / div;
+}
+
+#define nmea_gen_centi_tenths(val)  nmea_gen_div_round((val), NMEA_CENTI_SCALE / 10)
+#define nmea_gen_dist_tenths(val)   nmea_gen_div_round((val), NMEA_DIST_SCALE / 10)
+#else
+/**
+ * \brief Round to integer without libm, out of range values are saturated.
+ */
+rt_inline rt_int32_t nmea_gen_round(double val)
+{
+    if (val > NMEA_GEN_ROUND_MAX)
+        return (rt_int32_t)NMEA_GEN_ROUND_MAX;
+    if (val < -NMEA_GEN_ROUND_MAX)
+        return -(rt_int32_t)NMEA_GEN_ROUND_MAX;
+
+    return (rt_int32_t)((val < 0) ? val - 0.5 : val + 0.5);
+}
+
+#define nmea_gen_centi_tenths(val)  nmea_gen_round((val) * 10)
+#define nmea_gen_dist_tenths(val)   nmea_gen_round((val) * 10)
+#endif
+
+/**
+ * \brief Write latitude or longitude as [degree][min].[min/10000] and hemisphere.
+ * @param val coordinate of packet, positive.
+ * @param deg_width 2 - latitude, 3 - longitude.
+ * @param hemi hemisphere character of packet.
+ */
+static void nmea_gen_coord(nmea_gen_out_t *out, nmea_coord_t val, int deg_width, char hemi)
+{
+    rt_uint32_t deg, min;
+
+#ifdef NMEA_USING_FIXED_POINT
+    rt_uint32_t mag = (val < 0) ? 0u - (rt_uint32_t)val : (rt_uint32_t)val;
+
+    deg = mag / NMEA_COORD_SCALE;
+    /* 1e-7 degrees to 1e-4 minutes is * 60 / 1000 */
+    min = ((mag % NMEA_COORD_SCALE) * 6 + 50) / 100;
+    if (min >= 60 * NMEA_GEN_MIN_SCALE)
+    {
+        min -= 60 * NMEA_GEN_MIN_SCALE;
+        deg++;
+    }
+#else
+    rt_int32_t ndeg = nmea_gen_round(val * NMEA_GEN_MIN_SCALE);
+    rt_uint32_t mag = (ndeg < 0) ? 0u - (rt_uint32_t)ndeg : (rt_uint32_t)ndeg;
+
+    deg = mag / (100 * NMEA_GEN_MIN_SCALE);
+    min = mag % (100 * NMEA_GEN_MIN_SCALE);
+#endif
+
+    nmea_gen_comma(out);
+    nmea_gen_uint(out, deg, deg_width);
+    nmea_gen_digits2(out, (int)(min / NMEA_GEN_MIN_SCALE));
+    nmea_gen_char(out, '.');
+    nmea_gen_uint(out, min % NMEA_GEN_MIN_SCALE, 4);
+    nmea_gen_char_field(out, hemi);
+}
+
+/**
+ * \brief Write time field hhmmss.ss.
+ */
+static void nmea_gen_time(nmea_gen_out_t *out, const nmea_time_t *utc)
+{
+    nmea_gen_comma(out);
+    nmea_gen_digits2(out, (rt_uint32_t)utc->hour % 100);
+    nmea_gen_digits2(out, (rt_uint32_t)utc->min % 100);
+    nmea_gen_digits2(out, (rt_uint32_t)utc->sec % 100);
+    nmea_gen_char(out, '.');
+    nmea_gen_digits2(out, (rt_uint32_t)utc->hsec % 100);
+}
+
+/**
+ * \brief Start sentence: '$' (not in checksum), talker and sentence ID.
+ * Sentence is written into tmp when buffer may be too short for it.
+ */
+static void nmea_gen_begin(nmea_gen_out_t *out, char *buff, int buff_sz, char *tmp, const char *talker, const char *id)
+{
+    out->start = (buff_sz < NMEA_MAX_SENTENCE) ? tmp : buff;
+    out->ptr = out->start;
+    out->crc = 0;
+
+    *out->ptr++ = '$';
+    nmea_gen_char(out, talker[0]);
+    nmea_gen_char(out, talker[1]);
+    nmea_gen_char(out, id[0]);
+    nmea_gen_char(out, id[1]);
+    nmea_gen_char(out, id[2]);
+}
+
+/**
+ * \brief End sentence by checksum and CR LF.
+ * @return Sentence size or 0 if it does not fit into buffer
+ */
+static int nmea_gen_end(nmea_gen_out_t *out, char *buff, int buff_sz)
+{
+    int len;
+
+    *out->ptr++ = '*';
+    *out->ptr++ = nmea_gen_hex[out->crc >> 4];
+    *out->ptr++ = nmea_gen_hex[out->crc & 0x0F];
+    *out->ptr++ = '\r';
+    *out->ptr++ = '\n';
+
+    len = (int)(out->ptr - out->start);
+    NMEA_ASSERT(len <= NMEA_MAX_SENTENCE);
+
+    if (out->start != buff)
+    {
+        if (len > buff_sz)
+            return 0;
+        rt_memcpy(buff, out->start, len);
+    }
+
+    return len;
+}
+
+rt_inline const char *nmea_gen_talker(int talker)
+{
+    if (talker < NMEA_TALKER_NON || talker > NMEA_TALKER_GN)
+        talker = NMEA_TALKER_NON;
+
+    return nmea_gen_talker_tab[talker];
+}
+
+/**
+ * \brief Generate GGA sentence. DGPS fields are empty when age and station are zero.
+ * @param buff output buffer, sentence is not zero terminated.
+ * @param buff_sz buffer size.
+ * @param pack a pointer of packet structure.
+ * @return Sentence size or 0 if buffer is too short
+ */
+int nmea_gen_gga(char *buff, int buff_sz, const nmea_gga_t *pack)
+{
+    char tmp[NMEA_MAX_SENTENCE];
+    nmea_gen_out_t out;
+
+    NMEA_ASSERT(buff && pack);
+
+    nmea_gen_begin(&out, buff, buff_sz, tmp, nmea_gen_talker(pack->talker), "GGA");
+    nmea_gen_time(&out, &pack->utc);
+    nmea_gen_coord(&out, pack->lat, 2, pack->ns);
+    nmea_gen_coord(&out, pack->lon, 3, pack->ew);
+    nmea_gen_comma(&out);
+    nmea_gen_int(&out, pack->sig, 1);
+    nmea_gen_comma(&out);
+    nmea_gen_int(&out, pack->satinuse, 2);
+    nmea_gen_comma(&out);
+    nmea_gen_tenths(&out, nmea_gen_centi_tenths(pack->HDOP));
+    nmea_gen_comma(&out);
+    nmea_gen_tenths(&out, nmea_gen_dist_tenths(pack->elv));
+    nmea_gen_char_field(&out, pack->elv_units);
+    nmea_gen_comma(&out);
+    nmea_gen_tenths(&out, nmea_gen_dist_tenths(pack->diff));
+    nmea_gen_char_field(&out, pack->diff_units);
+    nmea_gen_comma(&out);
+    if (pack->dgps_age || pack->dgps_sid)
+        nmea_gen_tenths(&out, nmea_gen_centi_tenths(pack->dgps_age));
+    nmea_gen_comma(&out);
+    if (pack->dgps_age || pack->dgps_sid)
+        nmea_gen_int(&out, pack->dgps_sid, 4);
+
+    return nmea_gen_end(&out, buff, buff_sz);
+}
+
+/**
+ * \brief Generate GSA sentence. Zero PRNs are written as empty fields,
+ * system ID field is written only if it is set (NMEA 4.10).
+ * @return Sentence size or 0 if buffer is too short
+ */
+int nmea_gen_gsa(char *buff, int buff_sz, const nmea_gsa_t *pack)
+{
+    char tmp[NMEA_MAX_SENTENCE];
+    nmea_gen_out_t out;
+    int it;
+
+    NMEA_ASSERT(buff && pack);
+
+    nmea_gen_begin(&out, buff, buff_sz, tmp, nmea_gen_talker(pack->talker), "GSA");
+    nmea_gen_char_field(&out, pack->fix_mode);
+    nmea_gen_comma(&out);
+    nmea_gen_int(&out, pack->fix_type, 1);
+    for (it = 0; it < NMEA_MAXSAT; ++it)
+    {
+        nmea_gen_comma(&out);
+        if (pack->sat_prn[it])
+            nmea_gen_int(&out, pack->sat_prn[it], 2);
+    }
+    nmea_gen_comma(&out);
+    nmea_gen_tenths(&out, nmea_gen_centi_tenths(pack->PDOP));
+    nmea_gen_comma(&out);
+    nmea_gen_tenths(&out, nmea_gen_centi_tenths(pack->HDOP));
+    nmea_gen_comma(&out);
+    nmea_gen_tenths(&out, nmea_gen_centi_tenths(pack->VDOP));
+    if (pack->system_id)
+    {
+        nmea_gen_comma(&out);
+        nmea_gen_int(&out, pack->system_id, 1);
+    }
+
+    return nmea_gen_end(&out, buff, buff_sz);
+}
+
+/**
+ * \brief Generate GSV sentence by talker characters.
+ */
+static int nmea_gen_gsv_talker(char *buff, int buff_sz, const nmea_gsv_t *pack, const char *talker)
+{
+    char tmp[NMEA_MAX_SENTENCE];
+    nmea_gen_out_t out;
+    const nmea_satellite_t *sat;
+    int it, nsat;
+
+    nsat = pack->sat_count - (pack->pack_index - 1) * NMEA_SATINPACK;
+    if (nsat > NMEA_SATINPACK)
+        nsat = NMEA_SATINPACK;
+
+    nmea_gen_begin(&out, buff, buff_sz, tmp, talker, "GSV");
+    nmea_gen_comma(&out);
+    nmea_gen_int(&out, pack->pack_count, 1);
+    nmea_gen_comma(&out);
+    nmea_gen_int(&out, pack->pack_index, 1);
+    nmea_gen_comma(&out);
+    nmea_gen_int(&out, pack->sat_count, 2);
+    for (it = 0; it < nsat; ++it)
+    {
+        sat = &pack->sat_data[it];
+        nmea_gen_comma(&out);
+        nmea_gen_int(&out, sat->id, 2);
+        nmea_gen_comma(&out);
+        nmea_gen_int(&out, sat->elv, 2);
+        nmea_gen_comma(&out);
+        nmea_gen_int(&out, sat->azimuth, 3);
+        nmea_gen_comma(&out);
+        if (sat->sig)
+            nmea_gen_int(&out, sat->sig, 2);
+    }
+    if (pack->signal_id)
+    {
+        nmea_gen_comma(&out);
+        nmea_gen_char(&out, nmea_gen_hex[pack->signal_id & 0x0F]);
+    }
+
+    return nmea_gen_end(&out, buff, buff_sz);
+}
+
+/**
+ * \brief Generate GSV sentence. The last message of cycle has only its
+ * satellites, signal ID field is written only if it is set (NMEA 4.10).
+ * @param pack a pointer of packet structure, pack_index is 1..pack_count.
+ * @return Sentence size or 0 if buffer is too short
+ */
+int nmea_gen_gsv(char *buff, int buff_sz, const nmea_gsv_t *pack)
+{
+    NMEA_ASSERT(buff && pack);
+
+    return nmea_gen_gsv_talker(buff, buff_sz, pack, nmea_gen_talker(pack->talker));
+}
+
+/**
+ * \brief Generate RMC sentence. Magnetic variation is empty when its
+ * direction is not set, mode field is written only if it is set (NMEA 2.3).
+ * @return Sentence size or 0 if buffer is too short
+ */
+int nmea_gen_rmc(char *buff, int buff_sz, const nmea_rmc_t *pack)
+{
+    char tmp[NMEA_MAX_SENTENCE];
+    nmea_gen_out_t out;
+
+    NMEA_ASSERT(buff && pack);
+
+    nmea_gen_begin(&out, buff, buff_sz, tmp, nmea_gen_talker(pack->talker), "RMC");
+    nmea_gen_time(&out, &pack->utc);
+    nmea_gen_char_field(&out, pack->status);
+    nmea_gen_coord(&out, pack->lat, 2, pack->ns);
+    nmea_gen_coord(&out, pack->lon, 3, pack->ew);
+    nmea_gen_comma(&out);
+    nmea_gen_tenths(&out, nmea_gen_centi_tenths(pack->speed));
+    nmea_gen_comma(&out);
+    nmea_gen_tenths(&out, nmea_gen_centi_tenths(pack->direction));
+    nmea_gen_comma(&out);
+    nmea_gen_digits2(&out, (rt_uint32_t)pack->utc.day % 100);
+    nmea_gen_digits2(&out, (rt_uint32_t)(pack->utc.mon + 1) % 100);
+    nmea_gen_digits2(&out, (rt_uint32_t)pack->utc.year % 100);
+    nmea_gen_comma(&out);
+    if (pack->declin_ew)
+        nmea_gen_tenths(&out, nmea_gen_centi_tenths(pack->declination));
+    nmea_gen_char_field(&out, pack->declin_ew);
+    if (pack->mode)
+        nmea_gen_char_field(&out, pack->mode);
+
+    return nmea_gen_end(&out, buff, buff_sz);
+}
+
+/**
+ * \brief Generate VTG sentence.
+ * @return Sentence size or 0 if buffer is too short
+ */
+int nmea_gen_vtg(char *buff, int buff_sz, const nmea_vtg_t *pack)
+{
+    char tmp[NMEA_MAX_SENTENCE];
+    nmea_gen_out_t out;
+
+    NMEA_ASSERT(buff && pack);
+
+    nmea_gen_begin(&out, buff, buff_sz, tmp, nmea_gen_talker(pack->talker), "VTG");
+    nmea_gen_comma(&out);
+    nmea_gen_tenths(&out, nmea_gen_centi_tenths(pack->dir));
+    nmea_gen_char_field(&out, pack->dir_t);
+    nmea_gen_comma(&out);
+    nmea_gen_tenths(&out, nmea_gen_centi_tenths(pack->dec));
+    nmea_gen_char_field(&out, pack->dec_m);
+    nmea_gen_comma(&out);
+    nmea_gen_tenths(&out, nmea_gen_centi_tenths(pack->spn));
+    nmea_gen_char_field(&out, pack->spn_n);
+    nmea_gen_comma(&out);
+    nmea_gen_tenths(&out, nmea_gen_centi_tenths(pack->spk));
+    nmea_gen_char_field(&out, pack->spk_k);
+
+    return nmea_gen_end(&out, buff, buff_sz);
+}
+
+/**
+ * \brief Speed of nmea_info_t (km/h) in knots.
+ */
+rt_inline nmea_centi_t nmea_gen_knots(nmea_centi_t speed)
+{
+#ifdef NMEA_USING_FIXED_POINT
+    return (nmea_centi_t)(((rt_int64_t)speed * 1000 + (speed < 0 ? -926 : 926)) / 1852);
+#else
+    return speed / NMEA_TUD_KNOTS;
+#endif
+}
+
+/**
+ * \brief Fill GGA packet by nmea_info_t structure.
+ */
+void nmea_info2gga(const nmea_info_t *info, int talker, nmea_gga_t *pack)
+{
+    NMEA_ASSERT(info && pack);
+
+    rt_memset(pack, 0, sizeof(nmea_gga_t));
+    pack->talker = talker;
+    pack->utc = info->utc;
+    pack->lat = (info->lat < 0) ? -info->lat : info->lat;
+    pack->ns = (info->lat < 0) ? 'S' : 'N';
+    pack->lon = (info->lon < 0) ? -info->lon : info->lon;
+    pack->ew = (info->lon < 0) ? 'W' : 'E';
+    pack->sig = info->sig;
+    pack->satinuse = info->satinfo.inuse;
+    pack->HDOP = info->HDOP;
+    pack->elv = info->elv;
+    pack->elv_units = 'M';
+    pack->diff_units = 'M';
+}
+
+/**
+ * \brief Fill GSA packet by satellites of nmea_info_t structure (up to NMEA_MAXSAT).
+ */
+void nmea_info2gsa(const nmea_info_t *info, int talker, nmea_gsa_t *pack)
+{
+    int it, nuse = 0;
+
+    NMEA_ASSERT(info && pack);
+
+    rt_memset(pack, 0, sizeof(nmea_gsa_t));
+    pack->talker = talker;
+    pack->fix_mode = 'A';
+    pack->fix_type = info->fix;
+    pack->PDOP = info->PDOP;
+    pack->HDOP = info->HDOP;
+    pack->VDOP = info->VDOP;
+
+    for (it = 0; it < NMEA_MAXSAT; ++it)
+    {
+        if (info->satinfo.sat[it].in_use && info->satinfo.sat[it].id)
+            pack->sat_prn[nuse++] = info->satinfo.sat[it].id;
+    }
+}
+
+/**
+ * \brief Fill GSV packet by satellites of nmea_info_t structure (up to NMEA_MAXSAT).
+ * @param pack_idx message number, 1..pack_count.
+ */
+void nmea_info2gsv(const nmea_info_t *info, int talker, int pack_idx, nmea_gsv_t *pack)
+{
+    int isat, nsat;
+
+    NMEA_ASSERT(info && pack);
+
+    rt_memset(pack, 0, sizeof(nmea_gsv_t));
+    pack->talker = talker;
+    pack->sat_count = (info->satinfo.inview < NMEA_MAXSAT) ? info->satinfo.inview : NMEA_MAXSAT;
+    if (pack->sat_count < 0)
+        pack->sat_count = 0;
+    pack->pack_count = (pack->sat_count + NMEA_SATINPACK - 1) / NMEA_SATINPACK;
+    if (!pack->pack_count)
+        pack->pack_count = 1;
+    pack->pack_index = (pack_idx < 1 || pack_idx > pack->pack_count) ? 1 : pack_idx;
+
+    isat = (pack->pack_index - 1) * NMEA_SATINPACK;
+    for (nsat = 0; nsat < NMEA_SATINPACK && isat < pack->sat_count; ++nsat, ++isat)
+        pack->sat_data[nsat] = info->satinfo.sat[isat];
+}
+
+/**
+ * \brief Fill RMC packet by nmea_info_t structure, magnetic variation is
+ * left empty (declination of nmea_info_t is magnetic track of VTG).
+ */
+void nmea_info2rmc(const nmea_info_t *info, int talker, nmea_rmc_t *pack)
+{
+    NMEA_ASSERT(info && pack);
+
+    rt_memset(pack, 0, sizeof(nmea_rmc_t));
+    pack->talker = talker;
+    pack->utc = info->utc;
+    pack->status = (info->sig > 0) ? 'A' : 'V';
+    pack->lat = (info->lat < 0) ? -info->lat : info->lat;
+    pack->ns = (info->lat < 0) ? 'S' : 'N';
+    pack->lon = (info->lon < 0) ? -info->lon : info->lon;
+    pack->ew = (info->lon < 0) ? 'W' : 'E';
+    pack->speed = nmea_gen_knots(info->speed);
+    pack->direction = info->direction;
+    pack->mode = (info->sig > 0) ? 'A' : 'N';
+}
+
+/**
+ * \brief Fill VTG packet by nmea_info_t structure, reverse of nmea_vtg_info().
+ */
+void nmea_info2vtg(const nmea_info_t *info, int talker, nmea_vtg_t *pack)
+{
+    NMEA_ASSERT(info && pack);
+
+    rt_memset(pack, 0, sizeof(nmea_vtg_t));
+    pack->talker = talker;
+    pack->dir = info->direction;
+    pack->dir_t = 'T';
+    pack->dec = info->declination;
+    pack->dec_m = 'M';
+    pack->spn = nmea_gen_knots(info->speed);
+    pack->spn_n = 'N';
+    pack->spk = info->speed;
+    pack->spk_k = 'K';
+}
+
+/**
+ * \brief Satellites of system and signal in view, sorted by PRN.
+ * @return Number of satellites
+ */
+static int nmea_gen_sat_list(const nmea_sat_table_t *tab, int system, int signal,
+    const nmea_sat_entry_t **list)
+{
+    const nmea_sat_entry_t *sat;
+    int it, pos, nsat = 0;
+
+    for (it = 0; it < NMEA_SAT_TABLE_SIZE; ++it)
+    {
+        sat = &tab->sat[it];
+        if (!sat->prn || sat->system != system || sat->signal != signal || !nmea_sat_in_view(tab, sat))
+            continue;
+
+        for (pos = nsat++; pos > 0 && list[pos - 1]->prn > sat->prn; --pos)
+            list[pos] = list[pos - 1];
+        list[pos] = sat;
+    }
+
+    return nsat;
+}
+
+/**
+ * \brief Generate GSA sentence of system. It has the first NMEA_MAXSAT used
+ * satellites: every GSA of system replaces marks of the previous one, so
+ * the rest is not sent by the next GSA. Satellite tracked on several
+ * signals is listed once.
+ * @return Sentence size or -1 if buffer is too short
+ */
+static int nmea_gen_sat_gsa(char *buff, int buff_sz, const nmea_info_t *info, int talker,
+    int system, const nmea_sat_entry_t **list)
+{
+    const nmea_sat_table_t *tab = info->sattab;
+    nmea_gsa_t pack;
+    int signal, nsat, isat, iprn, nuse = 0, len;
+
+    nmea_info2gsa(info, talker, &pack);
+    pack.system_id = system;
+    rt_memset(pack.sat_prn, 0, sizeof(pack.sat_prn));
+
+    for (signal = 0; signal <= NMEA_GEN_MAX_SIGNAL && nuse < NMEA_MAXSAT; ++signal)
+    {
+        if (!(tab->signals[system] & (1 << signal)))
+            continue;
+
+        nsat = nmea_gen_sat_list(tab, system, signal, list);
+        for (isat = 0; isat < nsat && nuse < NMEA_MAXSAT; ++isat)
+        {
+            if (!nmea_sat_in_use(tab, list[isat]))
+                continue;
+            for (iprn = 0; iprn < nuse && pack.sat_prn[iprn] != list[isat]->prn; ++iprn)
+                ;
+            if (iprn == nuse)
+                pack.sat_prn[nuse++] = list[isat]->prn;
+        }
+    }
+
+    /* empty GSA of system is generated too, it drops previous marks */
+    len = nmea_gen_gsa(buff, buff_sz, &pack);
+
+    return len ? len : -1;
+}
+
+/**
+ * \brief Generate GSV cycles of system, one by signal, talker is the one of system.
+ * @param gen_size a pointer for return size of sentences which fit into buffer.
+ * @return 0 - success or -1 if buffer is too short
+ */
+static int nmea_gen_sat_gsv(char *buff, int buff_sz, const nmea_sat_table_t *tab,
+    int system, const nmea_sat_entry_t **list, int *gen_size)
+{
+    nmea_gsv_t pack;
+    nmea_satellite_t *dst;
+    int signal, nsat, isat, it, len;
+
+    *gen_size = 0;
+
+    for (signal = 0; signal <= NMEA_GEN_MAX_SIGNAL; ++signal)
+    {
+        if (!(tab->signals[system] & (1 << signal)))
+            continue;
+
+        nsat = nmea_gen_sat_list(tab, system, signal, list);
+        rt_memset(&pack, 0, sizeof(pack));
+        pack.sat_count = nsat;
+        pack.pack_count = (nsat + NMEA_SATINPACK - 1) / NMEA_SATINPACK;
+        pack.signal_id = signal;
+
+        for (isat = 0; isat < nsat; isat += NMEA_SATINPACK)
+        {
+            pack.pack_index = isat / NMEA_SATINPACK + 1;
+            for (it = 0; it < NMEA_SATINPACK && isat + it < nsat; ++it)
+            {
+                dst = &pack.sat_data[it];
+                dst->id = list[isat + it]->prn;
+                dst->in_use = nmea_sat_in_use(tab, list[isat + it]);
+                dst->elv = list[isat + it]->elv;
+                dst->azimuth = list[isat + it]->azimuth;
+                dst->sig = list[isat + it]->sig;
+            }
+
+            len = nmea_gen_gsv_talker(buff + *gen_size, buff_sz - *gen_size, &pack, nmea_gen_system_tab[system]);
+            if (!len)
+                return -1;
+            *gen_size += len;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * \brief Generate GSA and GSV sentences of all systems from satellites table.
+ * @param gen_size a pointer for return size of sentences which fit into buffer.
+ * @return 0 - success or -1 if buffer is too short
+ */
+static int nmea_gen_sat_table(char *buff, int buff_sz, const nmea_info_t *info, int talker,
+    int generate_mask, int *gen_size)
+{
+    const nmea_sat_entry_t *list[NMEA_SAT_TABLE_SIZE];
+    int system, len, res;
+
+    *gen_size = 0;
+
+    for (system = NMEA_SYSTEM_GPS; system < NMEA_SYSTEM_MAX; ++system)
+    {
+        if (!info->sattab->signals[system])
+            continue;
+
+        if (generate_mask & GPGSA)
+        {
+            len = nmea_gen_sat_gsa(buff + *gen_size, buff_sz - *gen_size, info, talker, system, list);
+            if (len < 0)
+                return -1;
+            *gen_size += len;
+        }
+        if (generate_mask & GPGSV)
+        {
+            res = nmea_gen_sat_gsv(buff + *gen_size, buff_sz - *gen_size, info->sattab, system, list, &len);
+            *gen_size += len;
+            if (res < 0)
+                return -1;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * \brief Generate sentences of summary information, in order GGA, GSA,
+ * GSV, RMC, VTG. With satellites table (info->sattab) GSA and GSV cover
+ * satellites of all systems: GSA by system with system ID (up to
+ * NMEA_MAXSAT used), GSV with all satellites in view by system talker and
+ * signal; otherwise they have satellites of info->satinfo.
+ * @param buff output buffer, sentences are not zero terminated.
+ * @param buff_sz buffer size.
+ * @param info a pointer of summary information structure.
+ * @param talker talker ID of sentences (NMEA_TALKER), NMEA_TALKER_GN for multi-GNSS receiver.
+ * @param generate_mask packet types to generate (NMEA_PACK_TYPE).
+ * @return Size of sentences which fit into buffer
+ */
+int nmea_generate(char *buff, int buff_sz, const nmea_info_t *info, int talker, int generate_mask)
+{
+    nmea_pack_t pack;
+    int it, len, gen_count = 0;
+
+    NMEA_ASSERT(buff && info);
+
+    if (generate_mask & GPGGA)
+    {
+        nmea_info2gga(info, talker, &pack.gga);
+        len = nmea_gen_gga(buff, buff_sz, &pack.gga);
+        if (!len)
+            return gen_count;
+        gen_count += len;
+    }
+
+    if (info->sattab && (generate_mask & (GPGSA | GPGSV)))
+    {
+        it = nmea_gen_sat_table(buff + gen_count, buff_sz - gen_count, info, talker, generate_mask, &len);
+        gen_count += len;
+        if (it < 0)
+            return gen_count;
+    }
+    else
+    {
+        if (generate_mask & GPGSA)
+        {
+            nmea_info2gsa(info, talker, &pack.gsa);
+            len = nmea_gen_gsa(buff + gen_count, buff_sz - gen_count, &pack.gsa);
+            if (!len)
+                return gen_count;
+            gen_count += len;
+        }
+        if (generate_mask & GPGSV)
+        {
+            nmea_info2gsv(info, talker, 1, &pack.gsv);
+            for (it = 1; it <= pack.gsv.pack_count; ++it)
+            {
+                nmea_info2gsv(info, talker, it, &pack.gsv);
+                len = nmea_gen_gsv(buff + gen_count, buff_sz - gen_count, &pack.gsv);
+                if (!len)
+                    return gen_count;
+                gen_count += len;
+            }
+        }
+    }
+
+    if (generate_mask & GPRMC)
+    {
+        nmea_info2rmc(info, talker, &pack.rmc);
+        len = nmea_gen_rmc(buff + gen_count, buff_sz - gen_count, &pack.rmc);
+        if (!len)
+            return gen_count;
+        gen_count += len;
+    }
+
+    if (generate_mask & GPVTG)
+    {
+        nmea_info2vtg(info, talker, &pack.vtg);
+        len = nmea_gen_vtg(buff + gen_count, buff_sz - gen_count, &pack.vtg);
+        if (!len)
+            return gen_count;
+        gen_count += len;
+    }
+
+    return gen_count;
+}
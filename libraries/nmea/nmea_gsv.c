@@ -0,0 +1,149 @@
+#include <nmea_parse.h>
+
+/*
+ * GSV cycle assembly: messages of one talker and signal are collected
+ * into view and marked in bitmap, view is published when bitmap has all
+ * messages 1..pack_count. Content hash of published view suppresses
+ * publication of the same sky again.
+ */
+
+#define NMEA_GSV_HASH_BASIS     (2166136261u)
+#define NMEA_GSV_HASH_PRIME     (16777619u)
+
+/**
+ * \brief FNV-1a hash of satellites in view.
+ */
+static rt_uint32_t nmea_gsv_hash(const nmea_gsv_view_t *view)
+{
+    const rt_uint8_t *ptr = (const rt_uint8_t *)view->sat;
+    const rt_uint8_t *end = ptr + view->sat_num * sizeof(nmea_satellite_t);
+    rt_uint32_t hash = NMEA_GSV_HASH_BASIS ^ (rt_uint32_t)view->sat_count;
+
+    for (; ptr < end; ++ptr)
+        hash = (hash ^ *ptr) * NMEA_GSV_HASH_PRIME;
+
+    return hash;
+}
+
+/**
+ * \brief Find stream of talker and signal or take free one.
+ * @return Pointer of stream or RT_NULL if all streams are used
+ */
+static nmea_gsv_stream_t *nmea_gsv_stream(nmea_gsv_asm_t *gsv_asm, int talker, int signal_id)
+{
+    nmea_gsv_stream_t *stream;
+    int it;
+
+    for (it = 0; it < gsv_asm->nstream; ++it)
+    {
+        stream = &gsv_asm->stream[it];
+        if (stream->view.talker == talker && stream->view.signal_id == signal_id)
+            return stream;
+    }
+
+    if (gsv_asm->nstream >= NMEA_GSV_MAX_STREAMS)
+        return RT_NULL;
+
+    stream = &gsv_asm->stream[gsv_asm->nstream++];
+    stream->view.talker = talker;
+    stream->view.signal_id = signal_id;
+
+    return stream;
+}
+
+/**
+ * \brief Initialize GSV assembler.
+ * @param gsv_asm a pointer of assembler.
+ * @param handler callback of complete and changed view.
+ * @param user_data user data passed to handler.
+ */
+void nmea_gsv_asm_init(nmea_gsv_asm_t *gsv_asm, nmea_gsv_handler_t handler, void *user_data)
+{
+    NMEA_ASSERT(gsv_asm);
+
+    rt_memset(gsv_asm, 0, sizeof(nmea_gsv_asm_t));
+    gsv_asm->handler = handler;
+    gsv_asm->user_data = user_data;
+}
+
+/**
+ * \brief Add GSV message to cycle of its talker and signal.
+ * Cycle which is replaced by message 1 of the next one, or repeats
+ * message it already has, before all messages arrived is counted as incomplete.
+ * @param gsv_asm a pointer of assembler.
+ * @param pack a pointer of GSV packet.
+ * @return 1 - view was published, 0 - cycle is not complete or view is not changed,
+ * -1 - message numbers are wrong or no free stream
+ */
+int nmea_gsv_asm_input(nmea_gsv_asm_t *gsv_asm, const nmea_gsv_t *pack)
+{
+    nmea_gsv_stream_t *stream;
+    nmea_gsv_view_t *view;
+    rt_uint32_t bit, hash;
+    int isat, isv;
+
+    NMEA_ASSERT(gsv_asm && pack);
+
+    if (pack->pack_count < 1 || pack->pack_count > NMEA_GSV_MAX_PACKS ||
+        pack->pack_index < 1 || pack->pack_index > pack->pack_count)
+        return -1;
+
+    stream = nmea_gsv_stream(gsv_asm, pack->talker, pack->signal_id);
+    if (!stream)
+    {
+        gsv_asm->overflow++;
+        return -1;
+    }
+
+    view = &stream->view;
+    bit = 1u << (pack->pack_index - 1);
+
+    /* message 1, duplicate or other size ends previous cycle */
+    if (1 == pack->pack_index || (stream->recv_mask & bit) || pack->pack_count != stream->pack_count)
+    {
+        if (stream->recv_mask)
+            gsv_asm->incomplete++;
+
+        stream->recv_mask = 0;
+        stream->pack_count = pack->pack_count;
+        view->sat_count = pack->sat_count;
+        view->sat_num = (pack->sat_count < NMEA_GSV_MAX_SAT) ? pack->sat_count : NMEA_GSV_MAX_SAT;
+        if (view->sat_num < 0)
+            view->sat_num = 0;
+        rt_memset(view->sat, 0, sizeof(view->sat));
+    }
+
+    isv = (pack->pack_index - 1) * NMEA_SATINPACK;
+    for (isat = 0; isat < NMEA_SATINPACK && isv < view->sat_num; ++isat, ++isv)
+        view->sat[isv] = pack->sat_data[isat];
+
+    stream->recv_mask |= bit;
+    if (stream->recv_mask != (0xFFFFFFFFu >> (32 - stream->pack_count)))
+        return 0;
+
+    stream->recv_mask = 0;
+    gsv_asm->complete++;
+
+    hash = nmea_gsv_hash(view);
+    if (stream->published && hash == stream->hash)
+        return 0;
+
+    stream->hash = hash;
+    stream->published = 1;
+    gsv_asm->published++;
+    if (gsv_asm->handler)
+        gsv_asm->handler(view, gsv_asm->user_data);
+
+    return 1;
+}
+
+/**
+ * \brief Packet handler of parser which feeds GSV packets to assembler.
+ * @param user_data a pointer of assembler (nmea_gsv_asm_t).
+ * @see nmea_parser_set_handler
+ */
+void nmea_gsv_asm_pack_handler(int ptype, void *pack, void *user_data)
+{
+    if (GPGSV == ptype)
+        nmea_gsv_asm_input((nmea_gsv_asm_t *)user_data, (const nmea_gsv_t *)pack);
+}
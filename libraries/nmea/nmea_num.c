@@ -0,0 +1,274 @@
+#include <nmea_parse.h>
+#include <stdlib.h>
+
+/*
+ * Number conversions working in place on (str, str_sz) fields of
+ * sentence: no copy, no locale, no strtod() for usual NMEA numbers.
+ */
+
+#define NMEA_NUM_MAX_DIGITS     (19) /**< Decimal digits which always fit into rt_uint64_t */
+#define NMEA_NUM_MAX_EXACT      (((rt_uint64_t)1) << 53) /**< Max integer exactly representable by double */
+#define NMEA_NUM_MAX_POW10      (22) /**< Max power of ten exactly representable by double */
+#define NMEA_NUM_NDEG_DIGITS    (9)  /**< Max fraction digits of minutes used by coordinate conversion */
+#define NMEA_NUM_NDEG_MAX_IPART (100000) /**< Bound of [d]ddmm part, keeps coordinate conversion in rt_int64_t */
+#define NMEA_NUM_MAX_INT32      (0x7FFFFFFFLL)
+
+static const double nmea_pow10_tab[NMEA_NUM_MAX_POW10 + 1] =
+{
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+static const rt_int64_t nmea_ipow10_tab[NMEA_NUM_NDEG_DIGITS + 1] =
+{
+    1LL, 10LL, 100LL, 1000LL, 10000LL, 100000LL, 1000000LL,
+    10000000LL, 100000000LL, 1000000000LL
+};
+
+/**
+ * Decimal number split into parts, as written in sentence
+ */
+typedef struct _nmea_decimal
+{
+    int         neg;        /**< Minus sign */
+    int         ndigits;    /**< Number of significant digits in mantissa */
+    int         nfrac;      /**< Number of mantissa digits after decimal point */
+    rt_uint64_t mant;       /**< All digits as integer */
+    rt_uint64_t ipart;      /**< Digits before decimal point as integer */
+} nmea_decimal_t;
+
+/**
+ * \brief Split decimal number [+-]ddd[.ddd]
+ * @param max_frac number of fraction digits to keep, the rest is ignored
+ * @return 0 - success, -1 - not a plain decimal number (empty, exponent, too many digits)
+ */
+static int nmea_decimal_split(const char *str, int str_sz, int max_frac, nmea_decimal_t *dec)
+{
+    const char *end_str = str + str_sz;
+    int digit, point = 0, ndigits = 0;
+
+    rt_memset(dec, 0, sizeof(nmea_decimal_t));
+
+    if (str < end_str && ('-' == *str || '+' == *str))
+        dec->neg = ('-' == *str++);
+
+    for (; str < end_str; ++str)
+    {
+        if ('.' == *str && !point)
+        {
+            point = 1;
+            dec->ipart = dec->mant;
+            continue;
+        }
+
+        digit = *str - '0';
+        if (digit < 0 || digit > 9)
+            break;
+
+        ndigits++;
+        if (point && dec->nfrac >= max_frac)
+            continue;
+        /* leading zeros are not significant */
+        if (dec->mant || digit)
+            dec->ndigits++;
+        if (dec->ndigits > NMEA_NUM_MAX_DIGITS)
+            return -1;
+        dec->mant = dec->mant * 10 + digit;
+        if (point)
+            dec->nfrac++;
+    }
+
+    if (!point)
+        dec->ipart = dec->mant;
+
+    /* exponent or no digits: not handled here */
+    if (!ndigits || (str < end_str && ('e' == *str || 'E' == *str)))
+        return -1;
+
+    return 0;
+}
+
+/**
+ * \brief Convert string to number, digits stop at first character out of radix
+ * @param res a pointer for return value, saturated on overflow.
+ * @return 0 - success or -1 - overflow
+ */
+int nmea_atoi_checked(const char *str, int str_sz, int radix, int *res)
+{
+    const char *end_str = str + str_sz;
+    rt_int64_t val = 0, max_val = NMEA_NUM_MAX_INT32;
+    int neg = 0, digit, over = 0;
+
+    if (str < end_str && ('-' == *str || '+' == *str))
+        neg = ('-' == *str++);
+    if (neg)
+        max_val++;
+
+    for (; str < end_str; ++str)
+    {
+        if (*str >= '0' && *str <= '9')
+            digit = *str - '0';
+        else if (*str >= 'a' && *str <= 'z')
+            digit = *str - 'a' + 10;
+        else if (*str >= 'A' && *str <= 'Z')
+            digit = *str - 'A' + 10;
+        else
+            break;
+
+        if (digit >= radix)
+            break;
+
+        val = val * radix + digit;
+        if (val > max_val)
+        {
+            val = max_val;
+            over = 1;
+        }
+    }
+
+    *res = (int)(neg ? -val : val);
+
+    return over ? -1 : 0;
+}
+
+/**
+ * \brief Convert string to number
+ * @return Value, saturated on overflow
+ */
+int nmea_atoi(const char *str, int str_sz, int radix)
+{
+    int res;
+
+    nmea_atoi_checked(str, str_sz, radix, &res);
+
+    return res;
+}
+
+/**
+ * \brief Convert string by strtod(), for numbers out of fast path
+ */
+static double nmea_atof_slow(const char *str, int str_sz)
+{
+    char *tmp_ptr;
+    char buff[NMEA_CONVSTR_BUF];
+    double res = 0;
+
+    if (str_sz < NMEA_CONVSTR_BUF)
+    {
+        rt_memcpy(&buff[0], str, str_sz);
+        buff[str_sz] = '\0';
+        res = strtod(&buff[0], &tmp_ptr);
+    }
+
+    return res;
+}
+
+/**
+ * \brief Convert string to fraction number.
+ * Up to 15 significant digits the result is exact quotient of two doubles,
+ * which is the correctly rounded value, same as strtod() gives.
+ */
+double nmea_atof(const char *str, int str_sz)
+{
+    nmea_decimal_t dec;
+    double res;
+
+    if (str_sz > 0 && (('0' <= *str && *str <= '9') || '.' == *str || '-' == *str || '+' == *str) &&
+        0 == nmea_decimal_split(str, str_sz, str_sz, &dec) &&
+        dec.mant <= NMEA_NUM_MAX_EXACT && dec.nfrac <= NMEA_NUM_MAX_POW10)
+    {
+        res = (double)dec.mant / nmea_pow10_tab[dec.nfrac];
+        return dec.neg ? -res : res;
+    }
+
+    return nmea_atof_slow(str, str_sz);
+}
+
+/**
+ * \brief Convert string to fixed point number, rounded half away from zero
+ * @param scale number of decimal digits after point, result is value * 10^scale.
+ * @param res a pointer for return value.
+ * @return 0 - success or -1 - format error or overflow
+ */
+int nmea_atofix(const char *str, int str_sz, int scale, rt_int32_t *res)
+{
+    nmea_decimal_t dec;
+    rt_int64_t val;
+
+    NMEA_ASSERT(scale >= 0 && scale < NMEA_NUM_NDEG_DIGITS);
+
+    /* one more digit than needed is kept for rounding; bound of mantissa
+     * keeps scaling below in rt_int64_t */
+    if (0 != nmea_decimal_split(str, str_sz, scale + 1, &dec) || dec.mant > NMEA_NUM_MAX_INT32 * 10)
+        return -1;
+
+    val = (rt_int64_t)dec.mant;
+    if (dec.nfrac > scale)
+        val = (val + 5) / 10;
+    else
+        val *= nmea_ipow10_tab[scale - dec.nfrac];
+
+    if (val > NMEA_NUM_MAX_INT32)
+        return -1;
+
+    *res = (rt_int32_t)(dec.neg ? -val : val);
+
+    return 0;
+}
+
+/**
+ * \brief Split coordinate [d]ddmm.mmmm into degrees and minutes
+ * @param mins a pointer for return minutes scaled by *scale.
+ * @return 0 - success or -1 - format error or out of range
+ */
+static int nmea_ndeg_split(const char *str, int str_sz, nmea_decimal_t *dec, rt_int64_t *deg, rt_int64_t *mins, rt_int64_t *scale)
+{
+    if (0 != nmea_decimal_split(str, str_sz, NMEA_NUM_NDEG_DIGITS, dec) || dec->ipart >= NMEA_NUM_NDEG_MAX_IPART)
+        return -1;
+
+    *scale = nmea_ipow10_tab[dec->nfrac];
+    *deg = (rt_int64_t)(dec->ipart / 100);
+    *mins = (rt_int64_t)dec->mant - *deg * 100 * *scale;
+
+    return 0;
+}
+
+/**
+ * \brief Convert coordinate [d]ddmm.mmmm (NDEG) to degrees
+ */
+double nmea_ndeg_atof(const char *str, int str_sz)
+{
+    nmea_decimal_t dec;
+    rt_int64_t deg, mins, scale;
+    double res;
+
+    if (0 != nmea_ndeg_split(str, str_sz, &dec, &deg, &mins, &scale))
+        return 0;
+
+    /* numerator and denominator are exact, so is the quotient rounding */
+    res = (double)(deg * 60 * scale + mins) / (double)(60 * scale);
+
+    return dec.neg ? -res : res;
+}
+
+/**
+ * \brief Convert coordinate [d]ddmm.mmmm (NDEG) to integer 1e-7 degrees
+ * @param res a pointer for return value.
+ * @return 0 - success or -1 - format error or overflow
+ */
+int nmea_ndeg_atofix(const char *str, int str_sz, rt_int32_t *res)
+{
+    nmea_decimal_t dec;
+    rt_int64_t deg, mins, scale, val;
+
+    if (0 != nmea_ndeg_split(str, str_sz, &dec, &deg, &mins, &scale))
+        return -1;
+
+    val = deg * 10000000LL + (mins * 10000000LL + 30 * scale) / (60 * scale);
+    if (val > NMEA_NUM_MAX_INT32)
+        return -1;
+
+    *res = (rt_int32_t)(dec.neg ? -val : val);
+
+    return 0;
+}
@@ -0,0 +1,476 @@
+#include <nmea_parse.h>
+#include <string.h>
+
+#ifdef NMEA_PARALLEL_USING_PTHREAD
+#include <pthread.h>
+#endif
+
+/*
+ * Parallel batch parse of complete input (log file): input is split at
+ * cycle boundaries, every chunk is parsed by nmea_parse_batch() on its
+ * own thread into private arrays, records are merged in input order.
+ * Chunk boundary is the first cycle end after nominal split point (time
+ * change, or packet which ends cycle), both neighbours find the same
+ * boundary by the same scan, so no cycle is split.
+ * Fix values are carried over cycles, so chunk parsed from clean fix may
+ * differ in its first records. After threads are done, every chunk is
+ * parsed again from the fix left by the previous one, until its fix at
+ * the end of record equals the one of the first parse: records from there
+ * on are the same already.
+ */
+
+#ifndef NMEA_PARALLEL_SNAP_COUNT
+#define NMEA_PARALLEL_SNAP_COUNT        (4) /**< Records of chunk whose fix is kept for check of second parse */
+#endif
+
+typedef struct _nmea_parallel_task
+{
+    nmea_batch_t batch;     /**< Private batch of chunk */
+    const char *buff;       /**< Chunk of input */
+    int         buff_sz;
+    rt_uint32_t base;       /**< Offset of chunk in input */
+    int         nread;      /**< Number of bytes whose cycles are in records */
+    int         complete;   /**< Whole chunk is in records */
+    int         started;    /**< Chunk is parsed by own thread */
+    int         redo;       /**< Second parse from fix of the previous chunk */
+    int         converged;  /**< Second parse reached fix of the first one */
+    nmea_batch_t *out;      /**< Batch records are written into */
+    nmea_epoch_handler_t record; /**< Record handler of batch */
+    nmea_info_t snap[NMEA_PARALLEL_SNAP_COUNT]; /**< Fix at the first records of the first parse */
+    nmea_info_t fix_end;    /**< Fix after the last record of chunk */
+    void       *mem;        /**< Storage of private arrays */
+#ifdef NMEA_PARALLEL_USING_PTHREAD
+    pthread_t   thread;
+#else
+    rt_sem_t    done;
+#endif
+} nmea_parallel_task_t;
+
+/** Shortest sentence "$*hh\r\n", bounds number of records of chunk */
+#define NMEA_PARALLEL_MIN_SENTENCE      (6)
+
+/** Stride of private arrays, keeps every array aligned to double */
+#define NMEA_PARALLEL_STRIDE(capacity)  RT_ALIGN((capacity), 8)
+
+#define NMEA_PARALLEL_ARRAY(dst, src, name, ptr) \
+    do { \
+        if ((src)->name) \
+        { \
+            (dst)->name = (void *)(ptr); \
+            (ptr) += NMEA_PARALLEL_STRIDE((dst)->capacity) * sizeof(*(src)->name); \
+        } \
+    } while (0)
+
+#define NMEA_PARALLEL_COPY(dst, src, name, at, n) \
+    do { \
+        if ((dst)->name) \
+            rt_memcpy((dst)->name + (at), (src)->name, (n) * sizeof(*(dst)->name)); \
+    } while (0)
+
+/**
+ * \brief Find cycle boundary at or after given offset: the first fix
+ * sentence (GGA, RMC, GNS, GLL) whose time differs from time of the first
+ * one, or the sentence after packet of last_type if cycle ends by it.
+ * @return Offset of boundary or buff_sz if there is no one
+ */
+static int nmea_parallel_seam(const char *buff, int buff_sz, int from, int last_type)
+{
+    const char *pos = buff + from, *end_buff = buff + buff_sz;
+    int ptype, nread, crc, utc_key, first_key = -1;
+    nmea_pack_t pack;
+
+    while (pos < end_buff)
+    {
+        pos = (const char *)memchr(pos, '$', end_buff - pos);
+        if (!pos)
+            break;
+
+        /* the same framing as nmea_parse_batch() does */
+        nread = nmea_find_tail(pos, (int)(end_buff - pos), &crc);
+        if (!nread)
+        {
+            ++pos;
+            continue;
+        }
+
+        ptype = (crc < 0) ? GPNON : nmea_pack_type(pos + 1, nread - 1);
+        if (GPNON != last_type)
+        {
+            /* cycle is ended by packet, time changes inside of it */
+            if (ptype == last_type && nmea_pack_decode(ptype, pos, nread, &pack) &&
+                (GPGSV != ptype || pack.gsv.pack_index >= pack.gsv.pack_count))
+                return (int)(pos - buff) + nread;
+        }
+        else if ((ptype & (GPGGA | GPRMC | GPGNS | GPGLL)) && nmea_pack_decode(ptype, pos, nread, &pack))
+        {
+            utc_key = nmea_epoch_utc(ptype, &pack);
+            if (first_key < 0)
+                first_key = utc_key;
+            else if (utc_key != first_key)
+                return (int)(pos - buff);
+        }
+
+        pos += nread;
+    }
+
+    return buff_sz;
+}
+
+/**
+ * \brief Record handler of chunk: keeps fix of the first records, or
+ * compares them in second parse and stops it when they are the same.
+ */
+static void nmea_parallel_record(const nmea_info_t *fix, void *user_data)
+{
+    nmea_parallel_task_t *task = (nmea_parallel_task_t *)user_data;
+    nmea_batch_t *out = task->out;
+    int rec = out->count;
+
+    task->record(fix, out);
+
+    if (rec >= NMEA_PARALLEL_SNAP_COUNT)
+        return;
+
+    if (!task->redo)
+        rt_memcpy(&task->snap[rec], fix, sizeof(nmea_info_t));
+    else if (0 == rt_memcmp(&task->snap[rec], fix, sizeof(nmea_info_t)))
+    {
+        /* the same fix gives the same records, parse stops at the next sentence */
+        task->converged = 1;
+        out->capacity = out->count + 1;
+    }
+}
+
+/**
+ * \brief Allocate private arrays of task for the same columns as caller's batch.
+ */
+static int nmea_parallel_alloc(nmea_parallel_task_t *task, const nmea_batch_t *batch)
+{
+    nmea_batch_t *dst = &task->batch;
+    int capacity = task->buff_sz / NMEA_PARALLEL_MIN_SENTENCE + 2;
+    rt_size_t size;
+    char *ptr;
+
+    nmea_batch_init(dst, (capacity < batch->capacity) ? capacity : batch->capacity, batch->epoch.last_type);
+    dst->err_capacity = batch->err_capacity;
+    task->record = dst->epoch.handler;
+    task->out = dst;
+    dst->epoch.handler = nmea_parallel_record;
+    dst->epoch.user_data = task;
+
+    /* private offsets are always kept, merge cuts records by them */
+    size = NMEA_PARALLEL_STRIDE(dst->capacity) * (sizeof(rt_uint32_t) * 4 +
+        sizeof(nmea_coord_t) * 2 + sizeof(nmea_dist_t) + sizeof(nmea_centi_t) * 3 + 2) +
+        NMEA_PARALLEL_STRIDE(dst->err_capacity) * sizeof(rt_uint32_t);
+
+    task->mem = rt_malloc(size);
+    if (!task->mem)
+        return 0;
+
+    ptr = (char *)task->mem;
+    dst->offset = (rt_uint32_t *)ptr;
+    ptr += NMEA_PARALLEL_STRIDE(dst->capacity) * sizeof(rt_uint32_t);
+    NMEA_PARALLEL_ARRAY(dst, batch, lat, ptr);
+    NMEA_PARALLEL_ARRAY(dst, batch, lon, ptr);
+    NMEA_PARALLEL_ARRAY(dst, batch, utc_ms, ptr);
+    NMEA_PARALLEL_ARRAY(dst, batch, date, ptr);
+    NMEA_PARALLEL_ARRAY(dst, batch, alt, ptr);
+    NMEA_PARALLEL_ARRAY(dst, batch, speed, ptr);
+    NMEA_PARALLEL_ARRAY(dst, batch, course, ptr);
+    NMEA_PARALLEL_ARRAY(dst, batch, hdop, ptr);
+    if (batch->err_offset)
+    {
+        dst->err_offset = (rt_uint32_t *)ptr;
+        ptr += NMEA_PARALLEL_STRIDE(dst->err_capacity) * sizeof(rt_uint32_t);
+    }
+    NMEA_PARALLEL_ARRAY(dst, batch, sig, ptr);
+    NMEA_PARALLEL_ARRAY(dst, batch, fix, ptr);
+
+    return 1;
+}
+
+/**
+ * \brief Parse chunk of task, the last cycle of chunk is complete.
+ */
+static void nmea_parallel_run(nmea_parallel_task_t *task)
+{
+    nmea_batch_t *batch = &task->batch;
+
+    task->nread = nmea_parse_batch(batch, task->buff, task->buff_sz);
+
+    /* parse stops before the end only if there is no room, or at incomplete sentence */
+    if (batch->count < batch->capacity - 1 || task->nread == task->buff_sz)
+    {
+        nmea_batch_flush(batch);
+        task->complete = 1;
+    }
+    else if (batch->epoch.fix.smask)
+    {
+        /* cycle in progress is left for the next call */
+        task->nread = (int)(batch->rec_offset - task->base);
+    }
+
+    rt_memcpy(&task->fix_end, &batch->epoch.fix, sizeof(nmea_info_t));
+}
+
+/**
+ * \brief Set fix of batch epoch to the one left by previous cycle.
+ */
+static void nmea_parallel_seed(nmea_batch_t *batch, const nmea_info_t *fix)
+{
+    rt_memcpy(&batch->epoch.fix, fix, sizeof(nmea_info_t));
+    batch->epoch.fix.smask = 0;
+    batch->epoch.utc_key = -1;
+}
+
+/**
+ * \brief Parse chunk again from fix of the previous chunk, records are
+ * written over the ones of the first parse until both parses have the same fix.
+ */
+static void nmea_parallel_redo(nmea_parallel_task_t *task, const nmea_info_t *seed)
+{
+    nmea_batch_t redo = task->batch;
+
+    nmea_batch_reset(&redo);
+    redo.base = task->base;
+    redo.err_offset = RT_NULL;
+    redo.err_capacity = 0;
+    nmea_epoch_init(&redo.epoch, task->batch.epoch.last_type, nmea_parallel_record, task);
+    nmea_parallel_seed(&redo, seed);
+
+    task->out = &redo;
+    task->redo = 1;
+    nmea_parse_batch(&redo, task->buff, task->buff_sz);
+    if (!task->converged)
+    {
+        if (task->complete)
+            nmea_batch_flush(&redo);
+        rt_memcpy(&task->fix_end, &redo.epoch.fix, sizeof(nmea_info_t));
+    }
+    task->out = &task->batch;
+}
+
+/**
+ * \brief Fix at cycle boundary inside of chunk, after its first records.
+ * @param end offset of boundary in input.
+ */
+static void nmea_parallel_fix_at(nmea_parallel_task_t *task, const nmea_info_t *seed,
+    rt_uint32_t end, nmea_info_t *fix)
+{
+    nmea_batch_t *tmp = &task->batch;
+
+    /* records are only counted, cycle before boundary is ended by flush */
+    nmea_batch_init(tmp, task->batch.capacity + 2, task->batch.epoch.last_type);
+    tmp->base = task->base;
+    nmea_parallel_seed(tmp, seed);
+    nmea_parse_batch(tmp, task->buff, (int)(end - task->base));
+    nmea_batch_flush(tmp);
+
+    rt_memcpy(fix, &tmp->epoch.fix, sizeof(nmea_info_t));
+}
+
+#ifdef NMEA_PARALLEL_USING_PTHREAD
+static void *nmea_parallel_entry(void *parameter)
+{
+    nmea_parallel_run((nmea_parallel_task_t *)parameter);
+
+    return RT_NULL;
+}
+
+static int nmea_parallel_start(nmea_parallel_task_t *task)
+{
+    return 0 == pthread_create(&task->thread, RT_NULL, nmea_parallel_entry, task);
+}
+
+static void nmea_parallel_join(nmea_parallel_task_t *task)
+{
+    pthread_join(task->thread, RT_NULL);
+}
+#else
+static void nmea_parallel_entry(void *parameter)
+{
+    nmea_parallel_task_t *task = (nmea_parallel_task_t *)parameter;
+
+    nmea_parallel_run(task);
+    rt_sem_release(task->done);
+}
+
+static int nmea_parallel_start(nmea_parallel_task_t *task)
+{
+    rt_thread_t thread;
+
+    task->done = rt_sem_create("nmea", 0, RT_IPC_FLAG_FIFO);
+    if (!task->done)
+        return 0;
+
+    /* SMP scheduler spreads threads of the same priority over cores */
+    thread = rt_thread_create("nmea", nmea_parallel_entry, task, NMEA_PARALLEL_STACK_SIZE,
+        rt_thread_self()->current_priority, 10);
+    if (!thread)
+    {
+        rt_sem_delete(task->done);
+        return 0;
+    }
+
+    rt_thread_startup(thread);
+
+    return 1;
+}
+
+static void nmea_parallel_join(nmea_parallel_task_t *task)
+{
+    rt_sem_take(task->done, RT_WAITING_FOREVER);
+    rt_sem_delete(task->done);
+}
+#endif
+
+/**
+ * \brief Append records and errors of task to caller's batch.
+ * @param end a pointer for return of offset in input after taken records.
+ * @return 1 - whole chunk was taken, 0 - batch is full or chunk is incomplete
+ */
+static int nmea_parallel_merge(nmea_batch_t *batch, nmea_parallel_task_t *task, rt_uint32_t *end)
+{
+    nmea_batch_t *src = &task->batch;
+    int it, at = batch->count, nrec = src->count;
+
+    if (nrec > batch->capacity - at)
+        nrec = batch->capacity - at;
+
+    /* cut chunk at the first record which has no room */
+    *end = (nrec < src->count) ? src->offset[nrec] : task->base + (rt_uint32_t)task->nread;
+
+    NMEA_PARALLEL_COPY(batch, src, offset, at, nrec);
+    NMEA_PARALLEL_COPY(batch, src, utc_ms, at, nrec);
+    NMEA_PARALLEL_COPY(batch, src, date, at, nrec);
+    NMEA_PARALLEL_COPY(batch, src, lat, at, nrec);
+    NMEA_PARALLEL_COPY(batch, src, lon, at, nrec);
+    NMEA_PARALLEL_COPY(batch, src, alt, at, nrec);
+    NMEA_PARALLEL_COPY(batch, src, speed, at, nrec);
+    NMEA_PARALLEL_COPY(batch, src, course, at, nrec);
+    NMEA_PARALLEL_COPY(batch, src, hdop, at, nrec);
+    NMEA_PARALLEL_COPY(batch, src, sig, at, nrec);
+    NMEA_PARALLEL_COPY(batch, src, fix, at, nrec);
+    batch->count += nrec;
+
+    for (it = 0; it < src->err_count; ++it)
+    {
+        if (src->err_offset && it < src->err_capacity)
+        {
+            if (src->err_offset[it] >= *end)
+                break;
+            if (batch->err_count < batch->err_capacity)
+                batch->err_offset[batch->err_count] = src->err_offset[it];
+        }
+        batch->err_count++;
+    }
+
+    return nrec == src->count && task->complete;
+}
+
+/**
+ * \brief Parse complete input by several threads, records are written
+ * in input order as nmea_parse_batch() would write them. Fix values kept
+ * by batch are the base of the first cycle, cycle in progress is not used;
+ * the last cycle is flushed.
+ * Parse stops when output arrays are full, continue with the rest of
+ * input after nmea_batch_reset().
+ * @param batch a pointer of batch, output arrays are set by caller.
+ * @param buff a constant character pointer of input.
+ * @param buff_sz input size.
+ * @param nthreads number of threads, up to NMEA_PARALLEL_MAX_THREADS,
+ * the calling thread parses the first chunk.
+ * @return Number of bytes was processed
+ */
+int nmea_parse_parallel(nmea_batch_t *batch, const char *buff, int buff_sz, int nthreads)
+{
+    nmea_parallel_task_t *task;
+    const nmea_info_t *seed;
+    int it, ntask, from, next, whole = 1;
+    rt_uint32_t end;
+
+    NMEA_ASSERT(batch && buff);
+
+    if (nthreads > NMEA_PARALLEL_MAX_THREADS)
+        nthreads = NMEA_PARALLEL_MAX_THREADS;
+    if (nthreads < 1)
+        nthreads = 1;
+
+    task = (nmea_parallel_task_t *)rt_malloc(nthreads * sizeof(nmea_parallel_task_t));
+    if (!task)
+    {
+        nmea_error("Insufficient memory!");
+        return 0;
+    }
+    rt_memset(task, 0, nthreads * sizeof(nmea_parallel_task_t));
+
+    /* split input, short input gives less chunks */
+    for (ntask = 0, from = 0; ntask < nthreads && from < buff_sz; ++ntask, from = next)
+    {
+        next = (int)((rt_int64_t)buff_sz * (ntask + 1) / nthreads);
+        next = (ntask + 1 < nthreads) ?
+            nmea_parallel_seam(buff, buff_sz, (next > from) ? next : from, batch->epoch.last_type) : buff_sz;
+
+        task[ntask].buff = buff + from;
+        task[ntask].buff_sz = next - from;
+        if (!nmea_parallel_alloc(&task[ntask], batch))
+        {
+            nmea_error("Insufficient memory!");
+            break;
+        }
+        task[ntask].base = batch->base + (rt_uint32_t)from;
+        task[ntask].batch.base = task[ntask].base;
+    }
+
+    /* the first chunk goes on from fix of batch, the others are checked after parse */
+    if (ntask)
+        nmea_parallel_seed(&task[0].batch, &batch->epoch.fix);
+
+    for (it = 1; it < ntask; ++it)
+        task[it].started = nmea_parallel_start(&task[it]);
+
+    for (it = 0; it < ntask; ++it)
+    {
+        if (!task[it].started)
+            nmea_parallel_run(&task[it]);
+    }
+
+    for (it = 0; it < ntask; ++it)
+    {
+        if (task[it].started)
+            nmea_parallel_join(&task[it]);
+    }
+
+    for (it = 1; it < ntask && task[it - 1].complete; ++it)
+        nmea_parallel_redo(&task[it], &task[it - 1].fix_end);
+
+    end = batch->base;
+    for (it = 0; it < ntask; ++it)
+    {
+        whole = nmea_parallel_merge(batch, &task[it], &end);
+        if (!whole)
+            break;
+    }
+
+    /* fix at the end of taken records is the base for the rest of input */
+    if (ntask)
+    {
+        if (whole)
+            nmea_parallel_seed(batch, &task[it - 1].fix_end);
+        else
+        {
+            seed = it ? &task[it - 1].fix_end : &batch->epoch.fix;
+            nmea_parallel_fix_at(&task[it], seed, end, &task[it].fix_end);
+            nmea_parallel_seed(batch, &task[it].fix_end);
+        }
+    }
+
+    for (it = 0; it < nthreads; ++it)
+        rt_free(task[it].mem);
+    rt_free(task);
+
+    from = (int)(end - batch->base);
+    batch->base = end;
+
+    return from;
+}
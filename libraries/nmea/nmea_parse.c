@@ -0,0 +1,2823 @@
+#include <nmea_parse.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <stddef.h>
+
+#define NMEA_TOKS_COMPARE   (1)
+#define NMEA_TOKS_PERCENT   (2)
+#define NMEA_TOKS_WIDTH     (3)
+#define NMEA_TOKS_TYPE      (4)
+
+/*
+ * Framing states, see nmea_framer_t
+ */
+#define NMEA_FRAME_HUNT     (0) /**< Waiting for '$' */
+#define NMEA_FRAME_BODY     (1) /**< Between '$' and '*' */
+#define NMEA_FRAME_CRC1     (2) /**< First checksum digit */
+#define NMEA_FRAME_CRC2     (3) /**< Second checksum digit */
+#define NMEA_FRAME_CR       (4) /**< Waiting for '\r' */
+#define NMEA_FRAME_LF       (5) /**< Waiting for '\n' */
+#define NMEA_FRAME_UBX_SYNC (6) /**< UBX frame, waiting for second sync byte */
+#define NMEA_FRAME_UBX_HEAD (7) /**< UBX frame, class, ID and length */
+#define NMEA_FRAME_UBX_BODY (8) /**< UBX frame, payload and checksum */
+#define NMEA_FRAME_RTCM_HEAD (9) /**< RTCM3 frame, reserved bits and length */
+#define NMEA_FRAME_RTCM_BODY (10) /**< RTCM3 frame, payload and CRC */
+
+#define NMEA_UBX_SYNC1      (0xB5)
+#define NMEA_UBX_SYNC2      (0x62)
+
+/* size of sentence length header in parser cache */
+#define NMEA_FRAME_HEAD     (2)
+/* flags of length header, frame is UBX or RTCM3 one */
+#define NMEA_FRAME_UBX      (0x8000)
+#define NMEA_FRAME_RTCM     (0x4000)
+#define NMEA_FRAME_LEN_MASK (0x3FFF)
+
+typedef struct _nmea_parser_node
+{
+    int packType;
+    void *pack;
+    struct _nmea_parser_node *next_node;
+#ifdef NMEA_USING_PACK_POOL
+    nmea_pack_t storage;
+#endif
+} nmea_parser_node_t;
+
+#ifdef NMEA_USING_PACK_POOL
+#define NMEA_PACK_POOL_BUFF     (NMEA_PACK_POOL_SIZE * \
+    (RT_ALIGN(sizeof(nmea_parser_node_t), RT_ALIGN_SIZE) + sizeof(rt_uint8_t *)))
+#endif
+
+/**
+ * Receiver of sentences found by framing, returns number of packets
+ * produced (0 or 1) or -1 if parsing must be stopped
+ */
+typedef int (*nmea_sentence_sink_t)(
+    nmea_parser_t *parser, int ptype,
+    const char *buff, int buff_sz,
+    void *ctx
+);
+
+static int nmea_parser_queue_clear(nmea_parser_t *parser);
+static int nmea_parser_push(nmea_parser_t *parser, const char *buff, int buff_sz);
+static int nmea_parser_push_sink(
+    nmea_parser_t *parser,
+    const char *buff, int buff_sz,
+    nmea_sentence_sink_t sink, void *ctx
+);
+static int nmea_parser_pop(nmea_parser_t *parser, void **pack_ptr);
+static void nmea_parser_node_free(nmea_parser_t *parser, nmea_parser_node_t *node);
+
+ /**
+  * \brief Initialization of parser object
+  * @return true (1) - success or false (0) - fail
+  */
+int nmea_parser_init(nmea_parser_t *parser)
+{
+    int resv = 0;
+    int buff_size = NMEA_DEF_PARSEBUFF;
+
+    NMEA_ASSERT(parser);
+
+    if (buff_size < NMEA_MIN_PARSEBUFF)
+        buff_size = NMEA_MIN_PARSEBUFF;
+    if (buff_size < NMEA_FRAME_HEAD + NMEA_MAX_FRAME)
+        buff_size = NMEA_FRAME_HEAD + NMEA_MAX_FRAME;
+
+    rt_memset(parser, 0, sizeof(nmea_parser_t));
+    parser->enable_mask = NMEA_PACK_TYPE_ALL;
+    /* mirror of cache head is kept behind its end */
+    parser->buffer = rt_malloc(buff_size + NMEA_MAX_FRAME);
+    if (RT_NULL == parser->buffer)
+    {
+        nmea_error("Insufficient memory!");
+        resv = -1;
+    }
+    else
+    {
+        parser->buff_size = buff_size;
+        resv = 1;
+    }
+
+#ifdef NMEA_USING_PACK_POOL
+    if (resv > 0)
+    {
+        /* all packets of queue are taken from this pool, no heap used after init */
+        parser->pack_pool = rt_malloc(NMEA_PACK_POOL_BUFF);
+        if (RT_NULL == parser->pack_pool)
+        {
+            nmea_error("Insufficient memory!");
+            rt_free(parser->buffer);
+            parser->buffer = RT_NULL;
+            resv = -1;
+        }
+        else
+        {
+            rt_mp_init(&parser->pack_mp, "nmea", parser->pack_pool,
+                NMEA_PACK_POOL_BUFF, sizeof(nmea_parser_node_t));
+        }
+    }
+#endif
+
+    return resv;
+}
+
+/**
+ * \brief Destroy parser object
+ */
+void nmea_parser_destroy(nmea_parser_t *parser)
+{
+    NMEA_ASSERT(parser && parser->buffer);
+    rt_free(parser->buffer);
+    nmea_parser_queue_clear(parser);
+#ifdef NMEA_USING_PACK_POOL
+    rt_mp_detach(&parser->pack_mp);
+    rt_free(parser->pack_pool);
+#endif
+    rt_memset(parser, 0, sizeof(nmea_parser_t));
+}
+
+int _nmea_parse_time(const char *buff, int buff_sz, nmea_time_t *res)
+{
+    int success = 0;
+
+    switch (buff_sz)
+    {
+    case sizeof("hhmmss") - 1:
+        success = (3 == nmea_scanf(buff, buff_sz,
+            "%2d%2d%2d", &(res->hour), &(res->min), &(res->sec)
+        ));
+        break;
+    case sizeof("hhmmss.s") - 1:
+    case sizeof("hhmmss.ss") - 1:
+    case sizeof("hhmmss.sss") - 1:
+        success = (4 == nmea_scanf(buff, buff_sz,
+            "%2d%2d%2d.%d", &(res->hour), &(res->min), &(res->sec), &(res->hsec)
+        ));
+        break;
+    default:
+        nmea_error("Parse of time error (format error)!");
+        success = 0;
+        break;
+    }
+
+    return (success ? 0 : -1);
+}
+
+/** Key of three characters, to switch on sentence ID or talker ID */
+#define NMEA_KEY3(a, b, c)      (((rt_uint32_t)(rt_uint8_t)(a) << 16) | ((rt_uint32_t)(rt_uint8_t)(b) << 8) | (rt_uint8_t)(c))
+#define NMEA_KEY2(a, b)         NMEA_KEY3(0, a, b)
+
+/**
+ * \brief Define packet type by header (NMEA_PACK_TYPE), talker ID is not compared.
+ * @param buff a constant character pointer of packet buffer (after '$').
+ * @param buff_sz buffer size.
+ * @return The defined packet type
+ * @see NMEA_PACK_TYPE
+ */
+int nmea_pack_type(const char *buff, int buff_sz)
+{
+    NMEA_ASSERT(buff);
+
+    if (buff_sz < 5 || 'P' == buff[0])
+        return GPNON;
+
+    switch (NMEA_KEY3(buff[2], buff[3], buff[4]))
+    {
+    case NMEA_KEY3('G', 'G', 'A'):
+        return GPGGA;
+    case NMEA_KEY3('G', 'S', 'A'):
+        return GPGSA;
+    case NMEA_KEY3('G', 'S', 'V'):
+        return GPGSV;
+    case NMEA_KEY3('R', 'M', 'C'):
+        return GPRMC;
+    case NMEA_KEY3('V', 'T', 'G'):
+        return GPVTG;
+    case NMEA_KEY3('G', 'L', 'L'):
+        return GPGLL;
+    case NMEA_KEY3('Z', 'D', 'A'):
+        return GPZDA;
+    case NMEA_KEY3('G', 'S', 'T'):
+        return GPGST;
+    case NMEA_KEY3('G', 'N', 'S'):
+        return GPGNS;
+    case NMEA_KEY3('G', 'R', 'S'):
+        return GPGRS;
+    case NMEA_KEY3('D', 'T', 'M'):
+        return GPDTM;
+    case NMEA_KEY3('H', 'D', 'T'):
+        return GPHDT;
+    };
+
+    return GPNON;
+}
+
+/**
+ * \brief Define talker of packet by header (NMEA_TALKER).
+ * @param buff a constant character pointer of packet buffer (after '$').
+ * @param buff_sz buffer size.
+ * @return The defined talker ID
+ * @see NMEA_TALKER
+ */
+int nmea_pack_talker(const char *buff, int buff_sz)
+{
+    NMEA_ASSERT(buff);
+
+    if (buff_sz < 2)
+        return NMEA_TALKER_NON;
+
+    switch (NMEA_KEY2(buff[0], buff[1]))
+    {
+    case NMEA_KEY2('G', 'P'):
+        return NMEA_TALKER_GP;
+    case NMEA_KEY2('G', 'L'):
+        return NMEA_TALKER_GL;
+    case NMEA_KEY2('G', 'A'):
+        return NMEA_TALKER_GA;
+    case NMEA_KEY2('G', 'B'):
+        return NMEA_TALKER_GB;
+    case NMEA_KEY2('B', 'D'):
+        return NMEA_TALKER_BD;
+    case NMEA_KEY2('G', 'Q'):
+        return NMEA_TALKER_GQ;
+    case NMEA_KEY2('G', 'N'):
+        return NMEA_TALKER_GN;
+    };
+
+    return NMEA_TALKER_NON;
+}
+
+/**
+ * \brief Find tail of packet ("\r\n") in buffer and check control sum (CRC).
+ * @param buff a constant character pointer of packets buffer.
+ * @param buff_sz buffer size.
+ * @param res_crc a integer pointer for return CRC of packet (must be defined).
+ * @return Number of bytes to packet tail.
+ */
+int nmea_find_tail(const char *buff, int buff_sz, int *res_crc)
+{
+    static const int tail_sz = 3 /* *[CRC] */ + 2 /* \r\n */;
+
+    const char *end_buff = buff + buff_sz;
+    int pos, crc;
+
+    NMEA_ASSERT(buff && res_crc);
+
+    *res_crc = -1;
+
+    pos = nmea_scan_sentence(buff, buff_sz, &crc);
+    if (pos >= buff_sz)
+        return 0;
+
+    /* start of next sentence, this one is broken */
+    if ('$' == buff[pos])
+        return pos;
+
+    buff += pos;
+    if (buff + tail_sz > end_buff || '\r' != buff[3] || '\n' != buff[4])
+        return 0;
+
+    *res_crc = nmea_atoi(buff + 1, 2, 16);
+    if (*res_crc != crc)
+        *res_crc = -1;
+
+    return pos + tail_sz;
+}
+
+/**
+ * \brief Find tail of packet char by char, the reference for nmea_find_tail().
+ * @see nmea_find_tail
+ */
+int nmea_find_tail_ref(const char *buff, int buff_sz, int *res_crc)
+{
+    static const int tail_sz = 3 /* *[CRC] */ + 2 /* \r\n */;
+
+    const char *end_buff = buff + buff_sz;
+    int nread = 0;
+    int crc = 0;
+
+    NMEA_ASSERT(buff && res_crc);
+
+    *res_crc = -1;
+
+    for (; buff < end_buff; ++buff, ++nread)
+    {
+        if (('$' == *buff) && nread)
+        {
+            buff = 0;
+            break;
+        }
+        else if ('*' == *buff)
+        {
+            if (buff + tail_sz <= end_buff && '\r' == buff[3] && '\n' == buff[4])
+            {
+                *res_crc = nmea_atoi(buff + 1, 2, 16);
+                nread = buff_sz - (int)(end_buff - (buff + tail_sz));
+                if (*res_crc != crc)
+                {
+                    *res_crc = -1;
+                    buff = 0;
+                }
+            }
+
+            break;
+        }
+        else if (nread)
+            crc ^= (int)*buff;
+    }
+
+    if (*res_crc < 0 && buff)
+        nread = 0;
+
+    return nread;
+}
+
+/**
+ * \brief Take signal ID of GSV packet (NMEA 4.10), it follows the last
+ * satellite and so is decoded in place of next satellite ID.
+ * @param buff a constant character pointer of packet buffer.
+ * @param buff_sz buffer size.
+ * @param pack a pointer of packet decoded from buffer.
+ */
+static void nmea_gsv_signal(const char *buff, int buff_sz, nmea_gsv_t *pack)
+{
+    const char *end_buff = buff + buff_sz;
+    const char *tok = RT_NULL;
+    int nfield = 0, nsat;
+
+    for (; buff < end_buff && '*' != *buff; ++buff)
+    {
+        if (',' == *buff)
+        {
+            nfield++;
+            tok = buff + 1;
+        }
+    }
+
+    /* three fields of header, four fields by satellite */
+    if (!tok || nfield < 4 || 1 != (nfield - 3) % 4)
+        return;
+
+    pack->signal_id = nmea_atoi(tok, (int)(buff - tok), 16);
+
+    nsat = (nfield - 3) / 4;
+    if (nsat < NMEA_SATINPACK)
+        rt_memset(&(pack->sat_data[nsat]), 0, sizeof(nmea_satellite_t));
+}
+
+#ifndef NMEA_USING_FIXED_POINT
+
+/**
+ * \brief Parse GGA packet from buffer by nmea_scanf().
+ * @param buff a constant character pointer of packet buffer.
+ * @param buff_sz buffer size.
+ * @param pack a pointer of packet which will filled by function.
+ * @return 1 (true) - if parsed successfully or 0 (false) - if fail.
+ */
+static int nmea_scanf_gga(const char *buff, int buff_sz, nmea_gga_t *pack)
+{
+    char time_buff[NMEA_TIMEPARSE_BUF];
+
+    NMEA_ASSERT(buff && pack);
+
+    rt_memset(pack, 0, sizeof(nmea_gga_t));
+    pack->talker = nmea_pack_talker(buff + 1, buff_sz - 1);
+
+    if (14 != nmea_scanf(buff + 3, buff_sz - 3,
+        "GGA,%s,%f,%C,%f,%C,%d,%d,%f,%f,%C,%f,%C,%f,%d*",
+        &(time_buff[0]),
+        &(pack->lat), &(pack->ns), &(pack->lon), &(pack->ew),
+        &(pack->sig), &(pack->satinuse), &(pack->HDOP), &(pack->elv), &(pack->elv_units),
+        &(pack->diff), &(pack->diff_units), &(pack->dgps_age), &(pack->dgps_sid)))
+    {
+        nmea_error("GPGGA parse error!");
+        return 0;
+    }
+
+    if (0 != _nmea_parse_time(&time_buff[0], (int)rt_strlen(&time_buff[0]), &(pack->utc)))
+    {
+        nmea_error("GPGGA time parse error!");
+        return 0;
+    }
+
+    return 1;
+}
+
+/**
+ * \brief Parse GSA packet from buffer by nmea_scanf().
+ * @param buff a constant character pointer of packet buffer.
+ * @param buff_sz buffer size.
+ * @param pack a pointer of packet which will filled by function.
+ * @return 1 (true) - if parsed successfully or 0 (false) - if fail.
+ */
+static int nmea_scanf_gsa(const char *buff, int buff_sz, nmea_gsa_t *pack)
+{
+    int nsen;
+
+    NMEA_ASSERT(buff && pack);
+
+    rt_memset(pack, 0, sizeof(nmea_gsa_t));
+    pack->talker = nmea_pack_talker(buff + 1, buff_sz - 1);
+
+    nsen = nmea_scanf(buff + 3, buff_sz - 3,
+        "GSA,%C,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%d,%f,%f,%f,%d*",
+        &(pack->fix_mode), &(pack->fix_type),
+        &(pack->sat_prn[0]), &(pack->sat_prn[1]), &(pack->sat_prn[2]), &(pack->sat_prn[3]), &(pack->sat_prn[4]), &(pack->sat_prn[5]),
+        &(pack->sat_prn[6]), &(pack->sat_prn[7]), &(pack->sat_prn[8]), &(pack->sat_prn[9]), &(pack->sat_prn[10]), &(pack->sat_prn[11]),
+        &(pack->PDOP), &(pack->HDOP), &(pack->VDOP), &(pack->system_id));
+
+    /* system ID is optional (NMEA 4.10 and later) */
+    if (nsen != 17 && nsen != 18)
+    {
+        nmea_error("GPGSA parse error!");
+        return 0;
+    }
+
+    return 1;
+}
+
+/**
+ * \brief Parse GSV packet from buffer by nmea_scanf().
+ * @param buff a constant character pointer of packet buffer.
+ * @param buff_sz buffer size.
+ * @param pack a pointer of packet which will filled by function.
+ * @return 1 (true) - if parsed successfully or 0 (false) - if fail.
+ */
+static int nmea_scanf_gsv(const char *buff, int buff_sz, nmea_gsv_t *pack)
+{
+    int nsen, nsat;
+
+    NMEA_ASSERT(buff && pack);
+
+    rt_memset(pack, 0, sizeof(nmea_gsv_t));
+    pack->talker = nmea_pack_talker(buff + 1, buff_sz - 1);
+
+    nsen = nmea_scanf(buff + 3, buff_sz - 3,
+        "GSV,%d,%d,%d,"
+        "%d,%d,%d,%d,"
+        "%d,%d,%d,%d,"
+        "%d,%d,%d,%d,"
+        "%d,%d,%d,%d*",
+        &(pack->pack_count), &(pack->pack_index), &(pack->sat_count),
+        &(pack->sat_data[0].id), &(pack->sat_data[0].elv), &(pack->sat_data[0].azimuth), &(pack->sat_data[0].sig),
+        &(pack->sat_data[1].id), &(pack->sat_data[1].elv), &(pack->sat_data[1].azimuth), &(pack->sat_data[1].sig),
+        &(pack->sat_data[2].id), &(pack->sat_data[2].elv), &(pack->sat_data[2].azimuth), &(pack->sat_data[2].sig),
+        &(pack->sat_data[3].id), &(pack->sat_data[3].elv), &(pack->sat_data[3].azimuth), &(pack->sat_data[3].sig));
+
+    nsat = (pack->pack_index - 1) * NMEA_SATINPACK;
+    nsat = (nsat + NMEA_SATINPACK > pack->sat_count) ? pack->sat_count - nsat : NMEA_SATINPACK;
+    nsat = nsat * 4 + 3 /* first three sentence`s */;
+
+    if (nsen < nsat || nsen >(NMEA_SATINPACK * 4 + 3))
+    {
+        nmea_error("GPGSV parse error!");
+        return 0;
+    }
+
+    nmea_gsv_signal(buff, buff_sz, pack);
+
+    return 1;
+}
+
+/**
+ * \brief Parse RMC packet from buffer by nmea_scanf().
+ * @param buff a constant character pointer of packet buffer.
+ * @param buff_sz buffer size.
+ * @param pack a pointer of packet which will filled by function.
+ * @return 1 (true) - if parsed successfully or 0 (false) - if fail.
+ */
+static int nmea_scanf_rmc(const char *buff, int buff_sz, nmea_rmc_t *pack)
+{
+    int nsen;
+    char time_buff[NMEA_TIMEPARSE_BUF];
+
+    NMEA_ASSERT(buff && pack);
+
+    rt_memset(pack, 0, sizeof(nmea_rmc_t));
+    pack->talker = nmea_pack_talker(buff + 1, buff_sz - 1);
+
+    nsen = nmea_scanf(buff + 3, buff_sz - 3,
+        "RMC,%s,%C,%f,%C,%f,%C,%f,%f,%2d%2d%2d,%f,%C,%C*",
+        &(time_buff[0]),
+        &(pack->status), &(pack->lat), &(pack->ns), &(pack->lon), &(pack->ew),
+        &(pack->speed), &(pack->direction),
+        &(pack->utc.day), &(pack->utc.mon), &(pack->utc.year),
+        &(pack->declination), &(pack->declin_ew), &(pack->mode));
+
+    if (nsen != 13 && nsen != 14)
+    {
+        nmea_error("GPRMC parse error!");
+        return 0;
+    }
+
+    if (0 != _nmea_parse_time(&time_buff[0], (int)rt_strlen(&time_buff[0]), &(pack->utc)))
+    {
+        nmea_error("GPRMC time parse error!");
+        return 0;
+    }
+
+    if (pack->utc.year < 90)
+        pack->utc.year += 100;
+    pack->utc.mon -= 1;
+
+    return 1;
+}
+
+/**
+ * \brief Parse VTG packet from buffer by nmea_scanf().
+ * @param buff a constant character pointer of packet buffer.
+ * @param buff_sz buffer size.
+ * @param pack a pointer of packet which will filled by function.
+ * @return 1 (true) - if parsed successfully or 0 (false) - if fail.
+ */
+static int nmea_scanf_vtg(const char *buff, int buff_sz, nmea_vtg_t *pack)
+{
+    NMEA_ASSERT(buff && pack);
+
+    rt_memset(pack, 0, sizeof(nmea_vtg_t));
+    pack->talker = nmea_pack_talker(buff + 1, buff_sz - 1);
+
+    if (8 != nmea_scanf(buff + 3, buff_sz - 3,
+        "VTG,%f,%C,%f,%C,%f,%C,%f,%C*",
+        &(pack->dir), &(pack->dir_t),
+        &(pack->dec), &(pack->dec_m),
+        &(pack->spn), &(pack->spn_n),
+        &(pack->spk), &(pack->spk_k)))
+    {
+        nmea_error("GPVTG parse error!");
+        return 0;
+    }
+
+    if (pack->dir_t != 'T' ||
+        pack->dec_m != 'M' ||
+        pack->spn_n != 'N' ||
+        pack->spk_k != 'K')
+    {
+        nmea_error("GPVTG parse error (format error)!");
+        return 0;
+    }
+
+    return 1;
+}
+
+#endif /* NMEA_USING_FIXED_POINT */
+
+/*
+ * Compiled decoders: every sentence type is described by table of its
+ * fields, the sentence is walked once and fields are written straight
+ * into packet structure.
+ */
+
+#define NMEA_FIELD_INT      (1) /**< int */
+#define NMEA_FIELD_COORD    (2) /**< nmea_coord_t, [d]ddmm.mmmm */
+#define NMEA_FIELD_CHAR     (3) /**< char, first character of field */
+#define NMEA_FIELD_TIME     (4) /**< nmea_time_t, hhmmss[.s..] */
+#define NMEA_FIELD_DATE     (5) /**< nmea_time_t, ddmmyy */
+#define NMEA_FIELD_DIST     (6) /**< nmea_dist_t */
+#define NMEA_FIELD_CENTI    (7) /**< nmea_centi_t */
+#define NMEA_FIELD_STR      (8) /**< char[NMEA_FIELD_STR_SIZE], zero terminated, longer text is cut */
+#define NMEA_FIELD_HEX      (9) /**< int, hexadecimal */
+
+typedef struct _nmea_field
+{
+    rt_uint8_t  type;   /**< NMEA_FIELD_xxx */
+    rt_uint16_t offset; /**< Offset of member in packet structure */
+} nmea_field_t;
+
+#define NMEA_FIELD(type, pack_t, member) { NMEA_FIELD_##type, (rt_uint16_t)offsetof(pack_t, member) }
+
+#ifndef NMEA_USING_SCANF_DECODER
+/* tables of common sentences, the old decoder reads them by nmea_scanf() */
+static const nmea_field_t nmea_gga_fields[] =
+{
+    NMEA_FIELD(TIME, nmea_gga_t, utc),
+    NMEA_FIELD(COORD, nmea_gga_t, lat),
+    NMEA_FIELD(CHAR, nmea_gga_t, ns),
+    NMEA_FIELD(COORD, nmea_gga_t, lon),
+    NMEA_FIELD(CHAR, nmea_gga_t, ew),
+    NMEA_FIELD(INT,  nmea_gga_t, sig),
+    NMEA_FIELD(INT,  nmea_gga_t, satinuse),
+    NMEA_FIELD(CENTI, nmea_gga_t, HDOP),
+    NMEA_FIELD(DIST, nmea_gga_t, elv),
+    NMEA_FIELD(CHAR, nmea_gga_t, elv_units),
+    NMEA_FIELD(DIST, nmea_gga_t, diff),
+    NMEA_FIELD(CHAR, nmea_gga_t, diff_units),
+    NMEA_FIELD(CENTI, nmea_gga_t, dgps_age),
+    NMEA_FIELD(INT,  nmea_gga_t, dgps_sid),
+};
+
+static const nmea_field_t nmea_gsa_fields[] =
+{
+    NMEA_FIELD(CHAR, nmea_gsa_t, fix_mode),
+    NMEA_FIELD(INT,  nmea_gsa_t, fix_type),
+    NMEA_FIELD(INT,  nmea_gsa_t, sat_prn[0]),
+    NMEA_FIELD(INT,  nmea_gsa_t, sat_prn[1]),
+    NMEA_FIELD(INT,  nmea_gsa_t, sat_prn[2]),
+    NMEA_FIELD(INT,  nmea_gsa_t, sat_prn[3]),
+    NMEA_FIELD(INT,  nmea_gsa_t, sat_prn[4]),
+    NMEA_FIELD(INT,  nmea_gsa_t, sat_prn[5]),
+    NMEA_FIELD(INT,  nmea_gsa_t, sat_prn[6]),
+    NMEA_FIELD(INT,  nmea_gsa_t, sat_prn[7]),
+    NMEA_FIELD(INT,  nmea_gsa_t, sat_prn[8]),
+    NMEA_FIELD(INT,  nmea_gsa_t, sat_prn[9]),
+    NMEA_FIELD(INT,  nmea_gsa_t, sat_prn[10]),
+    NMEA_FIELD(INT,  nmea_gsa_t, sat_prn[11]),
+    NMEA_FIELD(CENTI, nmea_gsa_t, PDOP),
+    NMEA_FIELD(CENTI, nmea_gsa_t, HDOP),
+    NMEA_FIELD(CENTI, nmea_gsa_t, VDOP),
+    NMEA_FIELD(INT,  nmea_gsa_t, system_id),
+};
+
+#define NMEA_GSV_SAT_FIELDS(n) \
+    NMEA_FIELD(INT,  nmea_gsv_t, sat_data[n].id), \
+    NMEA_FIELD(INT,  nmea_gsv_t, sat_data[n].elv), \
+    NMEA_FIELD(INT,  nmea_gsv_t, sat_data[n].azimuth), \
+    NMEA_FIELD(INT,  nmea_gsv_t, sat_data[n].sig)
+
+static const nmea_field_t nmea_gsv_fields[] =
+{
+    NMEA_FIELD(INT,  nmea_gsv_t, pack_count),
+    NMEA_FIELD(INT,  nmea_gsv_t, pack_index),
+    NMEA_FIELD(INT,  nmea_gsv_t, sat_count),
+    NMEA_GSV_SAT_FIELDS(0),
+    NMEA_GSV_SAT_FIELDS(1),
+    NMEA_GSV_SAT_FIELDS(2),
+    NMEA_GSV_SAT_FIELDS(3),
+};
+
+static const nmea_field_t nmea_rmc_fields[] =
+{
+    NMEA_FIELD(TIME, nmea_rmc_t, utc),
+    NMEA_FIELD(CHAR, nmea_rmc_t, status),
+    NMEA_FIELD(COORD, nmea_rmc_t, lat),
+    NMEA_FIELD(CHAR, nmea_rmc_t, ns),
+    NMEA_FIELD(COORD, nmea_rmc_t, lon),
+    NMEA_FIELD(CHAR, nmea_rmc_t, ew),
+    NMEA_FIELD(CENTI, nmea_rmc_t, speed),
+    NMEA_FIELD(CENTI, nmea_rmc_t, direction),
+    NMEA_FIELD(DATE, nmea_rmc_t, utc),
+    NMEA_FIELD(CENTI, nmea_rmc_t, declination),
+    NMEA_FIELD(CHAR, nmea_rmc_t, declin_ew),
+    NMEA_FIELD(CHAR, nmea_rmc_t, mode),
+};
+
+static const nmea_field_t nmea_vtg_fields[] =
+{
+    NMEA_FIELD(CENTI, nmea_vtg_t, dir),
+    NMEA_FIELD(CHAR, nmea_vtg_t, dir_t),
+    NMEA_FIELD(CENTI, nmea_vtg_t, dec),
+    NMEA_FIELD(CHAR, nmea_vtg_t, dec_m),
+    NMEA_FIELD(CENTI, nmea_vtg_t, spn),
+    NMEA_FIELD(CHAR, nmea_vtg_t, spn_n),
+    NMEA_FIELD(CENTI, nmea_vtg_t, spk),
+    NMEA_FIELD(CHAR, nmea_vtg_t, spk_k),
+};
+#endif
+
+static const nmea_field_t nmea_gll_fields[] =
+{
+    NMEA_FIELD(COORD, nmea_gll_t, lat),
+    NMEA_FIELD(CHAR, nmea_gll_t, ns),
+    NMEA_FIELD(COORD, nmea_gll_t, lon),
+    NMEA_FIELD(CHAR, nmea_gll_t, ew),
+    NMEA_FIELD(TIME, nmea_gll_t, utc),
+    NMEA_FIELD(CHAR, nmea_gll_t, status),
+    NMEA_FIELD(CHAR, nmea_gll_t, mode),
+};
+
+static const nmea_field_t nmea_zda_fields[] =
+{
+    NMEA_FIELD(TIME, nmea_zda_t, utc),
+    NMEA_FIELD(INT,  nmea_zda_t, utc.day),
+    NMEA_FIELD(INT,  nmea_zda_t, utc.mon),
+    NMEA_FIELD(INT,  nmea_zda_t, utc.year),
+    NMEA_FIELD(INT,  nmea_zda_t, zone_hour),
+    NMEA_FIELD(INT,  nmea_zda_t, zone_min),
+};
+
+static const nmea_field_t nmea_gst_fields[] =
+{
+    NMEA_FIELD(TIME, nmea_gst_t, utc),
+    NMEA_FIELD(DIST, nmea_gst_t, rms),
+    NMEA_FIELD(DIST, nmea_gst_t, err_major),
+    NMEA_FIELD(DIST, nmea_gst_t, err_minor),
+    NMEA_FIELD(CENTI, nmea_gst_t, err_orient),
+    NMEA_FIELD(DIST, nmea_gst_t, lat_err),
+    NMEA_FIELD(DIST, nmea_gst_t, lon_err),
+    NMEA_FIELD(DIST, nmea_gst_t, elv_err),
+};
+
+static const nmea_field_t nmea_gns_fields[] =
+{
+    NMEA_FIELD(TIME, nmea_gns_t, utc),
+    NMEA_FIELD(COORD, nmea_gns_t, lat),
+    NMEA_FIELD(CHAR, nmea_gns_t, ns),
+    NMEA_FIELD(COORD, nmea_gns_t, lon),
+    NMEA_FIELD(CHAR, nmea_gns_t, ew),
+    NMEA_FIELD(STR,  nmea_gns_t, mode),
+    NMEA_FIELD(INT,  nmea_gns_t, satinuse),
+    NMEA_FIELD(CENTI, nmea_gns_t, HDOP),
+    NMEA_FIELD(DIST, nmea_gns_t, elv),
+    NMEA_FIELD(DIST, nmea_gns_t, diff),
+    NMEA_FIELD(CENTI, nmea_gns_t, dgps_age),
+    NMEA_FIELD(INT,  nmea_gns_t, dgps_sid),
+    NMEA_FIELD(CHAR, nmea_gns_t, nav_status),
+};
+
+static const nmea_field_t nmea_grs_fields[] =
+{
+    NMEA_FIELD(TIME, nmea_grs_t, utc),
+    NMEA_FIELD(INT,  nmea_grs_t, mode),
+    NMEA_FIELD(DIST, nmea_grs_t, residual[0]),
+    NMEA_FIELD(DIST, nmea_grs_t, residual[1]),
+    NMEA_FIELD(DIST, nmea_grs_t, residual[2]),
+    NMEA_FIELD(DIST, nmea_grs_t, residual[3]),
+    NMEA_FIELD(DIST, nmea_grs_t, residual[4]),
+    NMEA_FIELD(DIST, nmea_grs_t, residual[5]),
+    NMEA_FIELD(DIST, nmea_grs_t, residual[6]),
+    NMEA_FIELD(DIST, nmea_grs_t, residual[7]),
+    NMEA_FIELD(DIST, nmea_grs_t, residual[8]),
+    NMEA_FIELD(DIST, nmea_grs_t, residual[9]),
+    NMEA_FIELD(DIST, nmea_grs_t, residual[10]),
+    NMEA_FIELD(DIST, nmea_grs_t, residual[11]),
+    NMEA_FIELD(INT,  nmea_grs_t, system_id),
+    NMEA_FIELD(HEX,  nmea_grs_t, signal_id),
+};
+
+static const nmea_field_t nmea_dtm_fields[] =
+{
+    NMEA_FIELD(STR,  nmea_dtm_t, datum),
+    NMEA_FIELD(STR,  nmea_dtm_t, sub_datum),
+    NMEA_FIELD(DIST, nmea_dtm_t, lat_ofs),
+    NMEA_FIELD(CHAR, nmea_dtm_t, ns),
+    NMEA_FIELD(DIST, nmea_dtm_t, lon_ofs),
+    NMEA_FIELD(CHAR, nmea_dtm_t, ew),
+    NMEA_FIELD(DIST, nmea_dtm_t, elv_ofs),
+    NMEA_FIELD(STR,  nmea_dtm_t, ref_datum),
+};
+
+static const nmea_field_t nmea_hdt_fields[] =
+{
+    NMEA_FIELD(CENTI, nmea_hdt_t, heading),
+    NMEA_FIELD(CHAR, nmea_hdt_t, heading_t),
+};
+
+#define NMEA_NFIELDS(fields)    ((int)(sizeof(fields) / sizeof(fields[0])))
+
+/**
+ * \brief Parse fixed width decimal number
+ * @return Value or -1 if not all characters are digits
+ */
+rt_inline int nmea_dec_fixed(const char *str, int width)
+{
+    int res = 0;
+
+    for (; width > 0; --width, ++str)
+    {
+        if (*str < '0' || *str > '9')
+            return -1;
+        res = res * 10 + (*str - '0');
+    }
+
+    return res;
+}
+
+/**
+ * \brief Parse time field (hhmmss, hhmmss.s, hhmmss.ss or hhmmss.sss)
+ * @return 0 - success or -1 - format error
+ */
+int nmea_field_time(const char *str, int str_sz, nmea_time_t *res)
+{
+    int hsec = 0;
+
+    if (str_sz != 6 && (str_sz < 8 || str_sz > 10 || '.' != str[6]))
+        return -1;
+
+    res->hour = nmea_dec_fixed(str, 2);
+    res->min = nmea_dec_fixed(str + 2, 2);
+    res->sec = nmea_dec_fixed(str + 4, 2);
+    if (str_sz > 7)
+    {
+        /* fraction of second, scaled to hundredths */
+        hsec = nmea_dec_fixed(str + 7, (str_sz > 9) ? 2 : str_sz - 7);
+        if (str_sz == 8)
+            hsec *= 10;
+    }
+    res->hsec = hsec;
+
+    return (res->hour < 0 || res->min < 0 || res->sec < 0 || hsec < 0) ? -1 : 0;
+}
+
+/**
+ * \brief Walk sentence fields once and write them into packet
+ * @param fields table of fields following the address field.
+ * @return Number of fields was found or -1 - format error
+ */
+static int nmea_fields_decode(
+    const char *buff, int buff_sz,
+    const nmea_field_t *fields, int nfields,
+    void *pack
+)
+{
+    const char *end_buff = buff + buff_sz;
+    const char *tok;
+    char *target;
+    int nfield = 0, width;
+
+    /* skip address field */
+    while (buff < end_buff && ',' != *buff && '*' != *buff)
+        ++buff;
+
+    for (; nfield < nfields && buff < end_buff && ',' == *buff; ++nfield, ++fields)
+    {
+        tok = ++buff;
+        while (buff < end_buff && ',' != *buff && '*' != *buff)
+            ++buff;
+
+        width = (int)(buff - tok);
+        target = (char *)pack + fields->offset;
+
+        switch (fields->type)
+        {
+        case NMEA_FIELD_INT:
+            if (width && nmea_atoi_checked(tok, width, 10, (int *)target) < 0)
+                return -1;
+            break;
+#ifdef NMEA_USING_FIXED_POINT
+        case NMEA_FIELD_COORD:
+            if (width && nmea_ndeg_atofix(tok, width, (rt_int32_t *)target) < 0)
+                return -1;
+            break;
+        case NMEA_FIELD_DIST:
+            if (width && nmea_atofix(tok, width, 3, (rt_int32_t *)target) < 0)
+                return -1;
+            break;
+        case NMEA_FIELD_CENTI:
+            if (width && nmea_atofix(tok, width, 2, (rt_int32_t *)target) < 0)
+                return -1;
+            break;
+#else
+        case NMEA_FIELD_COORD:
+        case NMEA_FIELD_DIST:
+        case NMEA_FIELD_CENTI:
+            if (width)
+                *((double *)target) = nmea_atof(tok, width);
+            break;
+#endif
+        case NMEA_FIELD_CHAR:
+            if (width)
+                *target = *tok;
+            break;
+        case NMEA_FIELD_STR:
+            if (width > NMEA_FIELD_STR_SIZE - 1)
+                width = NMEA_FIELD_STR_SIZE - 1;
+            rt_memcpy(target, tok, width);
+            target[width] = 0;
+            break;
+        case NMEA_FIELD_HEX:
+            if (width && nmea_atoi_checked(tok, width, 16, (int *)target) < 0)
+                return -1;
+            break;
+        case NMEA_FIELD_TIME:
+            if (nmea_field_time(tok, width, (nmea_time_t *)target) < 0)
+            {
+                nmea_error("Parse of time error (format error)!");
+                return -1;
+            }
+            break;
+        case NMEA_FIELD_DATE:
+            if (6 == width)
+            {
+                ((nmea_time_t *)target)->day = nmea_dec_fixed(tok, 2);
+                ((nmea_time_t *)target)->mon = nmea_dec_fixed(tok + 2, 2);
+                ((nmea_time_t *)target)->year = nmea_dec_fixed(tok + 4, 2);
+                if (((nmea_time_t *)target)->day < 0 || ((nmea_time_t *)target)->mon < 0 ||
+                    ((nmea_time_t *)target)->year < 0)
+                {
+                    nmea_error("Parse of date error (format error)!");
+                    return -1;
+                }
+            }
+            break;
+        };
+    }
+
+    return nfield;
+}
+
+/**
+ * \brief Parse GGA packet from buffer.
+ * @param buff a constant character pointer of packet buffer.
+ * @param buff_sz buffer size.
+ * @param pack a pointer of packet which will filled by function.
+ * @return 1 (true) - if parsed successfully or 0 (false) - if fail.
+ */
+int nmea_parse_gga(const char *buff, int buff_sz, nmea_gga_t *pack)
+{
+#ifdef NMEA_USING_SCANF_DECODER
+    return nmea_scanf_gga(buff, buff_sz, pack);
+#else
+    NMEA_ASSERT(buff && pack);
+
+    rt_memset(pack, 0, sizeof(nmea_gga_t));
+    pack->talker = nmea_pack_talker(buff + 1, buff_sz - 1);
+
+    if (NMEA_NFIELDS(nmea_gga_fields) != nmea_fields_decode(buff, buff_sz,
+        nmea_gga_fields, NMEA_NFIELDS(nmea_gga_fields), pack))
+    {
+        nmea_error("GPGGA parse error!");
+        return 0;
+    }
+
+    return 1;
+#endif
+}
+
+/**
+ * \brief Parse GSA packet from buffer.
+ * @param buff a constant character pointer of packet buffer.
+ * @param buff_sz buffer size.
+ * @param pack a pointer of packet which will filled by function.
+ * @return 1 (true) - if parsed successfully or 0 (false) - if fail.
+ */
+int nmea_parse_gsa(const char *buff, int buff_sz, nmea_gsa_t *pack)
+{
+#ifdef NMEA_USING_SCANF_DECODER
+    return nmea_scanf_gsa(buff, buff_sz, pack);
+#else
+    NMEA_ASSERT(buff && pack);
+
+    rt_memset(pack, 0, sizeof(nmea_gsa_t));
+    pack->talker = nmea_pack_talker(buff + 1, buff_sz - 1);
+
+    /* system ID is optional (NMEA 4.10 and later) */
+    if (NMEA_NFIELDS(nmea_gsa_fields) - 1 > nmea_fields_decode(buff, buff_sz,
+        nmea_gsa_fields, NMEA_NFIELDS(nmea_gsa_fields), pack))
+    {
+        nmea_error("GPGSA parse error!");
+        return 0;
+    }
+
+    return 1;
+#endif
+}
+
+/**
+ * \brief Parse GSV packet from buffer.
+ * @param buff a constant character pointer of packet buffer.
+ * @param buff_sz buffer size.
+ * @param pack a pointer of packet which will filled by function.
+ * @return 1 (true) - if parsed successfully or 0 (false) - if fail.
+ */
+int nmea_parse_gsv(const char *buff, int buff_sz, nmea_gsv_t *pack)
+{
+#ifdef NMEA_USING_SCANF_DECODER
+    return nmea_scanf_gsv(buff, buff_sz, pack);
+#else
+    int nsen, nsat;
+
+    NMEA_ASSERT(buff && pack);
+
+    rt_memset(pack, 0, sizeof(nmea_gsv_t));
+    pack->talker = nmea_pack_talker(buff + 1, buff_sz - 1);
+
+    nsen = nmea_fields_decode(buff, buff_sz,
+        nmea_gsv_fields, NMEA_NFIELDS(nmea_gsv_fields), pack);
+
+    nsat = (pack->pack_index - 1) * NMEA_SATINPACK;
+    nsat = (nsat + NMEA_SATINPACK > pack->sat_count) ? pack->sat_count - nsat : NMEA_SATINPACK;
+    nsat = nsat * 4 + 3 /* first three sentence`s */;
+
+    if (nsen < nsat)
+    {
+        nmea_error("GPGSV parse error!");
+        return 0;
+    }
+
+    nmea_gsv_signal(buff, buff_sz, pack);
+
+    return 1;
+#endif
+}
+
+/**
+ * \brief Parse RMC packet from buffer.
+ * @param buff a constant character pointer of packet buffer.
+ * @param buff_sz buffer size.
+ * @param pack a pointer of packet which will filled by function.
+ * @return 1 (true) - if parsed successfully or 0 (false) - if fail.
+ */
+int nmea_parse_rmc(const char *buff, int buff_sz, nmea_rmc_t *pack)
+{
+#ifdef NMEA_USING_SCANF_DECODER
+    return nmea_scanf_rmc(buff, buff_sz, pack);
+#else
+    int nsen;
+
+    NMEA_ASSERT(buff && pack);
+
+    rt_memset(pack, 0, sizeof(nmea_rmc_t));
+    pack->talker = nmea_pack_talker(buff + 1, buff_sz - 1);
+
+    nsen = nmea_fields_decode(buff, buff_sz,
+        nmea_rmc_fields, NMEA_NFIELDS(nmea_rmc_fields), pack);
+
+    /* mode indicator is optional (NMEA 2.3 and later) */
+    if (nsen < NMEA_NFIELDS(nmea_rmc_fields) - 1)
+    {
+        nmea_error("GPRMC parse error!");
+        return 0;
+    }
+
+    if (pack->utc.year < 90)
+        pack->utc.year += 100;
+    pack->utc.mon -= 1;
+
+    return 1;
+#endif
+}
+
+/**
+ * \brief Parse VTG packet from buffer.
+ * @param buff a constant character pointer of packet buffer.
+ * @param buff_sz buffer size.
+ * @param pack a pointer of packet which will filled by function.
+ * @return 1 (true) - if parsed successfully or 0 (false) - if fail.
+ */
+int nmea_parse_vtg(const char *buff, int buff_sz, nmea_vtg_t *pack)
+{
+#ifdef NMEA_USING_SCANF_DECODER
+    return nmea_scanf_vtg(buff, buff_sz, pack);
+#else
+    NMEA_ASSERT(buff && pack);
+
+    rt_memset(pack, 0, sizeof(nmea_vtg_t));
+    pack->talker = nmea_pack_talker(buff + 1, buff_sz - 1);
+
+    if (NMEA_NFIELDS(nmea_vtg_fields) != nmea_fields_decode(buff, buff_sz,
+        nmea_vtg_fields, NMEA_NFIELDS(nmea_vtg_fields), pack))
+    {
+        nmea_error("GPVTG parse error!");
+        return 0;
+    }
+
+    if (pack->dir_t != 'T' ||
+        pack->dec_m != 'M' ||
+        pack->spn_n != 'N' ||
+        pack->spk_k != 'K')
+    {
+        nmea_error("GPVTG parse error (format error)!");
+        return 0;
+    }
+
+    return 1;
+#endif
+}
+
+/**
+ * \brief Parse GLL packet from buffer.
+ * @param buff a constant character pointer of packet buffer.
+ * @param buff_sz buffer size.
+ * @param pack a pointer of packet which will filled by function.
+ * @return 1 (true) - if parsed successfully or 0 (false) - if fail.
+ */
+int nmea_parse_gll(const char *buff, int buff_sz, nmea_gll_t *pack)
+{
+    NMEA_ASSERT(buff && pack);
+
+    rt_memset(pack, 0, sizeof(nmea_gll_t));
+    pack->talker = nmea_pack_talker(buff + 1, buff_sz - 1);
+
+    /* mode indicator is optional (NMEA 2.3 and later) */
+    if (NMEA_NFIELDS(nmea_gll_fields) - 1 > nmea_fields_decode(buff, buff_sz,
+        nmea_gll_fields, NMEA_NFIELDS(nmea_gll_fields), pack))
+    {
+        nmea_error("GPGLL parse error!");
+        return 0;
+    }
+
+    return 1;
+}
+
+/**
+ * \brief Parse ZDA packet from buffer.
+ * @param buff a constant character pointer of packet buffer.
+ * @param buff_sz buffer size.
+ * @param pack a pointer of packet which will filled by function.
+ * @return 1 (true) - if parsed successfully or 0 (false) - if fail.
+ */
+int nmea_parse_zda(const char *buff, int buff_sz, nmea_zda_t *pack)
+{
+    NMEA_ASSERT(buff && pack);
+
+    rt_memset(pack, 0, sizeof(nmea_zda_t));
+    pack->talker = nmea_pack_talker(buff + 1, buff_sz - 1);
+
+    /* local zone is often not reported */
+    if (NMEA_NFIELDS(nmea_zda_fields) - 2 > nmea_fields_decode(buff, buff_sz,
+        nmea_zda_fields, NMEA_NFIELDS(nmea_zda_fields), pack))
+    {
+        nmea_error("GPZDA parse error!");
+        return 0;
+    }
+
+    /* full year in sentence, the same presentation as RMC date */
+    if (pack->utc.year < 1900 || pack->utc.mon < 1 || pack->utc.mon > 12)
+    {
+        nmea_error("GPZDA parse error (format error)!");
+        return 0;
+    }
+
+    pack->utc.year -= 1900;
+    pack->utc.mon -= 1;
+
+    return 1;
+}
+
+/**
+ * \brief Parse GST packet from buffer.
+ * @param buff a constant character pointer of packet buffer.
+ * @param buff_sz buffer size.
+ * @param pack a pointer of packet which will filled by function.
+ * @return 1 (true) - if parsed successfully or 0 (false) - if fail.
+ */
+int nmea_parse_gst(const char *buff, int buff_sz, nmea_gst_t *pack)
+{
+    NMEA_ASSERT(buff && pack);
+
+    rt_memset(pack, 0, sizeof(nmea_gst_t));
+    pack->talker = nmea_pack_talker(buff + 1, buff_sz - 1);
+
+    if (NMEA_NFIELDS(nmea_gst_fields) != nmea_fields_decode(buff, buff_sz,
+        nmea_gst_fields, NMEA_NFIELDS(nmea_gst_fields), pack))
+    {
+        nmea_error("GPGST parse error!");
+        return 0;
+    }
+
+    return 1;
+}
+
+/**
+ * \brief Parse GNS packet from buffer.
+ * @param buff a constant character pointer of packet buffer.
+ * @param buff_sz buffer size.
+ * @param pack a pointer of packet which will filled by function.
+ * @return 1 (true) - if parsed successfully or 0 (false) - if fail.
+ */
+int nmea_parse_gns(const char *buff, int buff_sz, nmea_gns_t *pack)
+{
+    NMEA_ASSERT(buff && pack);
+
+    rt_memset(pack, 0, sizeof(nmea_gns_t));
+    pack->talker = nmea_pack_talker(buff + 1, buff_sz - 1);
+
+    /* navigational status is optional (NMEA 4.10 and later) */
+    if (NMEA_NFIELDS(nmea_gns_fields) - 1 > nmea_fields_decode(buff, buff_sz,
+        nmea_gns_fields, NMEA_NFIELDS(nmea_gns_fields), pack))
+    {
+        nmea_error("GPGNS parse error!");
+        return 0;
+    }
+
+    return 1;
+}
+
+/**
+ * \brief Parse GRS packet from buffer.
+ * @param buff a constant character pointer of packet buffer.
+ * @param buff_sz buffer size.
+ * @param pack a pointer of packet which will filled by function.
+ * @return 1 (true) - if parsed successfully or 0 (false) - if fail.
+ */
+int nmea_parse_grs(const char *buff, int buff_sz, nmea_grs_t *pack)
+{
+    NMEA_ASSERT(buff && pack);
+
+    rt_memset(pack, 0, sizeof(nmea_grs_t));
+    pack->talker = nmea_pack_talker(buff + 1, buff_sz - 1);
+
+    /* system and signal ID are optional (NMEA 4.10 and later) */
+    if (NMEA_NFIELDS(nmea_grs_fields) - 2 > nmea_fields_decode(buff, buff_sz,
+        nmea_grs_fields, NMEA_NFIELDS(nmea_grs_fields), pack))
+    {
+        nmea_error("GPGRS parse error!");
+        return 0;
+    }
+
+    return 1;
+}
+
+/**
+ * \brief Parse DTM packet from buffer.
+ * @param buff a constant character pointer of packet buffer.
+ * @param buff_sz buffer size.
+ * @param pack a pointer of packet which will filled by function.
+ * @return 1 (true) - if parsed successfully or 0 (false) - if fail.
+ */
+int nmea_parse_dtm(const char *buff, int buff_sz, nmea_dtm_t *pack)
+{
+    NMEA_ASSERT(buff && pack);
+
+    rt_memset(pack, 0, sizeof(nmea_dtm_t));
+    pack->talker = nmea_pack_talker(buff + 1, buff_sz - 1);
+
+    if (NMEA_NFIELDS(nmea_dtm_fields) != nmea_fields_decode(buff, buff_sz,
+        nmea_dtm_fields, NMEA_NFIELDS(nmea_dtm_fields), pack))
+    {
+        nmea_error("GPDTM parse error!");
+        return 0;
+    }
+
+    return 1;
+}
+
+/**
+ * \brief Parse HDT packet from buffer.
+ * @param buff a constant character pointer of packet buffer.
+ * @param buff_sz buffer size.
+ * @param pack a pointer of packet which will filled by function.
+ * @return 1 (true) - if parsed successfully or 0 (false) - if fail.
+ */
+int nmea_parse_hdt(const char *buff, int buff_sz, nmea_hdt_t *pack)
+{
+    NMEA_ASSERT(buff && pack);
+
+    rt_memset(pack, 0, sizeof(nmea_hdt_t));
+    pack->talker = nmea_pack_talker(buff + 1, buff_sz - 1);
+
+    if (NMEA_NFIELDS(nmea_hdt_fields) != nmea_fields_decode(buff, buff_sz,
+        nmea_hdt_fields, NMEA_NFIELDS(nmea_hdt_fields), pack))
+    {
+        nmea_error("GPHDT parse error!");
+        return 0;
+    }
+
+    if (pack->heading_t != 'T')
+    {
+        nmea_error("GPHDT parse error (format error)!");
+        return 0;
+    }
+
+    return 1;
+}
+
+#ifndef NMEA_USING_FIXED_POINT
+/**
+ * \brief Parse packet of any supported type from buffer by nmea_scanf(),
+ * the reference for compiled decoders.
+ * @return 1 (true) - if parsed successfully or 0 (false) - if fail.
+ * @see nmea_pack_decode
+ */
+int nmea_pack_scanf(int ptype, const char *buff, int buff_sz, nmea_pack_t *pack)
+{
+    NMEA_ASSERT(buff && pack);
+
+    switch (ptype)
+    {
+    case GPGGA:
+        return nmea_scanf_gga(buff, buff_sz, &(pack->gga));
+    case GPGSA:
+        return nmea_scanf_gsa(buff, buff_sz, &(pack->gsa));
+    case GPGSV:
+        return nmea_scanf_gsv(buff, buff_sz, &(pack->gsv));
+    case GPRMC:
+        return nmea_scanf_rmc(buff, buff_sz, &(pack->rmc));
+    case GPVTG:
+        return nmea_scanf_vtg(buff, buff_sz, &(pack->vtg));
+    };
+
+    return 0;
+}
+#endif
+
+/**
+ * \brief Parse packet of any supported type from buffer.
+ * @param ptype packet type (NMEA_PACK_TYPE).
+ * @param buff a constant character pointer of packet buffer.
+ * @param buff_sz buffer size.
+ * @param pack a pointer of packet storage which will filled by function.
+ * @return 1 (true) - if parsed successfully or 0 (false) - if fail.
+ */
+int nmea_pack_decode(int ptype, const char *buff, int buff_sz, nmea_pack_t *pack)
+{
+    NMEA_ASSERT(buff && pack);
+
+    switch (ptype)
+    {
+    case GPGGA:
+        return nmea_parse_gga(buff, buff_sz, &(pack->gga));
+    case GPGSA:
+        return nmea_parse_gsa(buff, buff_sz, &(pack->gsa));
+    case GPGSV:
+        return nmea_parse_gsv(buff, buff_sz, &(pack->gsv));
+    case GPRMC:
+        return nmea_parse_rmc(buff, buff_sz, &(pack->rmc));
+    case GPVTG:
+        return nmea_parse_vtg(buff, buff_sz, &(pack->vtg));
+    case GPGLL:
+        return nmea_parse_gll(buff, buff_sz, &(pack->gll));
+    case GPZDA:
+        return nmea_parse_zda(buff, buff_sz, &(pack->zda));
+    case GPGST:
+        return nmea_parse_gst(buff, buff_sz, &(pack->gst));
+    case GPGNS:
+        return nmea_parse_gns(buff, buff_sz, &(pack->gns));
+    case GPGRS:
+        return nmea_parse_grs(buff, buff_sz, &(pack->grs));
+    case GPDTM:
+        return nmea_parse_dtm(buff, buff_sz, &(pack->dtm));
+    case GPHDT:
+        return nmea_parse_hdt(buff, buff_sz, &(pack->hdt));
+    };
+
+    return 0;
+}
+
+/**
+ * \brief Size of packet structure by packet type.
+ * @return Size in bytes or 0 for unknown packet type
+ */
+static int nmea_pack_size(int ptype)
+{
+    switch (ptype)
+    {
+    case GPGGA:
+        return sizeof(nmea_gga_t);
+    case GPGSA:
+        return sizeof(nmea_gsa_t);
+    case GPGSV:
+        return sizeof(nmea_gsv_t);
+    case GPRMC:
+        return sizeof(nmea_rmc_t);
+    case GPVTG:
+        return sizeof(nmea_vtg_t);
+    case GPGLL:
+        return sizeof(nmea_gll_t);
+    case GPZDA:
+        return sizeof(nmea_zda_t);
+    case GPGST:
+        return sizeof(nmea_gst_t);
+    case GPGNS:
+        return sizeof(nmea_gns_t);
+    case GPGRS:
+        return sizeof(nmea_grs_t);
+    case GPDTM:
+        return sizeof(nmea_dtm_t);
+    case GPHDT:
+        return sizeof(nmea_hdt_t);
+    };
+
+    return 0;
+}
+
+/**
+ * \brief Fill nmea_info_t structure by GGA packet data.
+ * @param pack a pointer of packet structure.
+ * @param info a pointer of summary information structure.
+ */
+void nmea_gga_info(nmea_gga_t *pack, nmea_info_t *info)
+{
+    NMEA_ASSERT(pack && info);
+
+    info->utc.hour = pack->utc.hour;
+    info->utc.min = pack->utc.min;
+    info->utc.sec = pack->utc.sec;
+    info->utc.hsec = pack->utc.hsec;
+    info->sig = pack->sig;
+    info->HDOP = pack->HDOP;
+    info->elv = pack->elv;
+    info->lat = ((pack->ns == 'N') ? pack->lat : -(pack->lat));
+    info->lon = ((pack->ew == 'E') ? pack->lon : -(pack->lon));
+    info->smask |= GPGGA;
+}
+
+/**
+ * \brief Fill nmea_info_t structure by GSA packet data.
+ * @param pack a pointer of packet structure.
+ * @param info a pointer of summary information structure.
+ */
+void nmea_gsa_info(nmea_gsa_t *pack, nmea_info_t *info)
+{
+    int i, j, nuse = 0;
+
+    NMEA_ASSERT(pack && info);
+
+    info->fix = pack->fix_type;
+    info->PDOP = pack->PDOP;
+    info->HDOP = pack->HDOP;
+    info->VDOP = pack->VDOP;
+    info->smask |= GPGSA;
+
+    if (info->sattab)
+    {
+        /* one GSA by system, total is kept by table */
+        nmea_sat_table_gsa(info->sattab, pack);
+        info->satinfo.inuse = nmea_sat_table_inuse(info->sattab);
+        return;
+    }
+
+    for (i = 0; i < NMEA_MAXSAT; ++i)
+    {
+        for (j = 0; j < info->satinfo.inview; ++j)
+        {
+            if (pack->sat_prn[i] && pack->sat_prn[i] == info->satinfo.sat[j].id)
+            {
+                info->satinfo.sat[j].in_use = 1;
+                nuse++;
+            }
+        }
+    }
+
+    info->satinfo.inuse = nuse;
+}
+
+/**
+ * \brief Fill nmea_info_t structure by GSV packet data.
+ * @param pack a pointer of packet structure.
+ * @param info a pointer of summary information structure.
+ */
+void nmea_gsv_info(nmea_gsv_t *pack, nmea_info_t *info)
+{
+    int isat, isi, nsat;
+
+    NMEA_ASSERT(pack && info);
+
+    if (info->sattab)
+    {
+        /* satellites are kept by table, total is taken when cycle is complete */
+        nmea_sat_table_gsv(info->sattab, pack);
+        if (pack->pack_index >= pack->pack_count)
+            info->satinfo.inview = nmea_sat_table_inview(info->sattab);
+        info->smask |= GPGSV;
+        return;
+    }
+
+    if (pack->pack_index > pack->pack_count ||
+        pack->pack_index * NMEA_SATINPACK > NMEA_MAXSAT)
+        return;
+
+    if (pack->pack_index < 1)
+        pack->pack_index = 1;
+
+    info->satinfo.inview = pack->sat_count;
+
+    nsat = (pack->pack_index - 1) * NMEA_SATINPACK;
+    nsat = (nsat + NMEA_SATINPACK > pack->sat_count) ? pack->sat_count - nsat : NMEA_SATINPACK;
+
+    for (isat = 0; isat < nsat; ++isat)
+    {
+        isi = (pack->pack_index - 1) * NMEA_SATINPACK + isat;
+        info->satinfo.sat[isi].id = pack->sat_data[isat].id;
+        info->satinfo.sat[isi].elv = pack->sat_data[isat].elv;
+        info->satinfo.sat[isi].azimuth = pack->sat_data[isat].azimuth;
+        info->satinfo.sat[isi].sig = pack->sat_data[isat].sig;
+    }
+
+    info->smask |= GPGSV;
+}
+
+/**
+ * \brief Fill nmea_info_t structure by RMC packet data.
+ * @param pack a pointer of packet structure.
+ * @param info a pointer of summary information structure.
+ */
+void nmea_rmc_info(nmea_rmc_t *pack, nmea_info_t *info)
+{
+    NMEA_ASSERT(pack && info);
+
+    if ('A' == pack->status)
+    {
+        if (NMEA_SIG_BAD == info->sig)
+            info->sig = NMEA_SIG_MID;
+        if (NMEA_FIX_BAD == info->fix)
+            info->fix = NMEA_FIX_2D;
+    }
+    else if ('V' == pack->status)
+    {
+        info->sig = NMEA_SIG_BAD;
+        info->fix = NMEA_FIX_BAD;
+    }
+
+    info->utc = pack->utc;
+    info->lat = ((pack->ns == 'N') ? pack->lat : -(pack->lat));
+    info->lon = ((pack->ew == 'E') ? pack->lon : -(pack->lon));
+#ifdef NMEA_USING_FIXED_POINT
+    info->speed = (nmea_centi_t)(((rt_int64_t)pack->speed * 1852 + 500) / 1000);
+#else
+    info->speed = pack->speed * NMEA_TUD_KNOTS;
+#endif
+    info->direction = pack->direction;
+    info->smask |= GPRMC;
+}
+
+/**
+ * \brief Fill nmea_info_t structure by VTG packet data.
+ * @param pack a pointer of packet structure.
+ * @param info a pointer of summary information structure.
+ */
+void nmea_vtg_info(nmea_vtg_t *pack, nmea_info_t *info)
+{
+    NMEA_ASSERT(pack && info);
+
+    info->direction = pack->dir;
+    info->declination = pack->dec;
+    info->speed = pack->spk;
+    info->smask |= GPVTG;
+}
+
+/**
+ * \brief Fill nmea_info_t structure by GLL packet data.
+ * @param pack a pointer of packet structure.
+ * @param info a pointer of summary information structure.
+ */
+void nmea_gll_info(nmea_gll_t *pack, nmea_info_t *info)
+{
+    NMEA_ASSERT(pack && info);
+
+    if ('V' == pack->status || 'N' == pack->mode)
+    {
+        info->sig = NMEA_SIG_BAD;
+        info->fix = NMEA_FIX_BAD;
+    }
+    else if ('A' == pack->status && NMEA_SIG_BAD == info->sig)
+    {
+        info->sig = NMEA_SIG_MID;
+    }
+
+    info->utc.hour = pack->utc.hour;
+    info->utc.min = pack->utc.min;
+    info->utc.sec = pack->utc.sec;
+    info->utc.hsec = pack->utc.hsec;
+    info->lat = ((pack->ns == 'N') ? pack->lat : -(pack->lat));
+    info->lon = ((pack->ew == 'E') ? pack->lon : -(pack->lon));
+    info->smask |= GPGLL;
+}
+
+/**
+ * \brief Fill nmea_info_t structure by ZDA packet data.
+ * @param pack a pointer of packet structure.
+ * @param info a pointer of summary information structure.
+ */
+void nmea_zda_info(nmea_zda_t *pack, nmea_info_t *info)
+{
+    NMEA_ASSERT(pack && info);
+
+    info->utc = pack->utc;
+    info->zone_min = pack->zone_hour * 60 + ((pack->zone_hour < 0) ? -pack->zone_min : pack->zone_min);
+    info->smask |= GPZDA;
+}
+
+/**
+ * \brief Fill nmea_info_t structure by GST packet data.
+ * @param pack a pointer of packet structure.
+ * @param info a pointer of summary information structure.
+ */
+void nmea_gst_info(nmea_gst_t *pack, nmea_info_t *info)
+{
+    NMEA_ASSERT(pack && info);
+
+    info->rms = pack->rms;
+    info->err_major = pack->err_major;
+    info->err_minor = pack->err_minor;
+    info->err_orient = pack->err_orient;
+    info->lat_err = pack->lat_err;
+    info->lon_err = pack->lon_err;
+    info->elv_err = pack->elv_err;
+    info->smask |= GPGST;
+}
+
+/**
+ * \brief GGA quality indicator of GNS mode character.
+ * @return Quality indicator or -1 for unknown mode
+ */
+static int nmea_gns_sig(char mode)
+{
+    static const char modes[] = "NADPRFEMS";
+    int sig;
+
+    for (sig = 0; modes[sig]; ++sig)
+    {
+        if (modes[sig] == mode)
+            return sig;
+    }
+
+    return -1;
+}
+
+/**
+ * \brief Fill nmea_info_t structure by GNS packet data.
+ * @param pack a pointer of packet structure.
+ * @param info a pointer of summary information structure.
+ */
+void nmea_gns_info(nmea_gns_t *pack, nmea_info_t *info)
+{
+    const char *mode;
+    int sig = NMEA_SIG_BAD, sys_sig;
+
+    NMEA_ASSERT(pack && info);
+
+    /* one character by system, fix of the best system is fix of receiver */
+    for (mode = pack->mode; *mode; ++mode)
+    {
+        sys_sig = nmea_gns_sig(*mode);
+        if (sys_sig > sig)
+            sig = sys_sig;
+    }
+
+    info->utc.hour = pack->utc.hour;
+    info->utc.min = pack->utc.min;
+    info->utc.sec = pack->utc.sec;
+    info->utc.hsec = pack->utc.hsec;
+    info->sig = sig;
+    info->HDOP = pack->HDOP;
+    info->elv = pack->elv;
+    info->lat = ((pack->ns == 'N') ? pack->lat : -(pack->lat));
+    info->lon = ((pack->ew == 'E') ? pack->lon : -(pack->lon));
+    info->smask |= GPGNS;
+}
+
+/**
+ * \brief Fill nmea_info_t structure by GRS packet data, residuals have
+ * no place in summary and only mark the cycle.
+ * @param pack a pointer of packet structure.
+ * @param info a pointer of summary information structure.
+ */
+void nmea_grs_info(nmea_grs_t *pack, nmea_info_t *info)
+{
+    NMEA_ASSERT(pack && info);
+
+    info->smask |= GPGRS;
+}
+
+/**
+ * \brief Fill nmea_info_t structure by DTM packet data.
+ * @param pack a pointer of packet structure.
+ * @param info a pointer of summary information structure.
+ */
+void nmea_dtm_info(nmea_dtm_t *pack, nmea_info_t *info)
+{
+    NMEA_ASSERT(pack && info);
+
+    rt_memcpy(info->datum, pack->datum, NMEA_FIELD_STR_SIZE);
+    info->smask |= GPDTM;
+}
+
+/**
+ * \brief Fill nmea_info_t structure by HDT packet data.
+ * @param pack a pointer of packet structure.
+ * @param info a pointer of summary information structure.
+ */
+void nmea_hdt_info(nmea_hdt_t *pack, nmea_info_t *info)
+{
+    NMEA_ASSERT(pack && info);
+
+    info->heading = pack->heading;
+    info->smask |= GPHDT;
+}
+
+/**
+ * \brief Fill nmea_info_t structure by packet data of any type.
+ * @param ptype packet type (NMEA_PACK_TYPE).
+ * @param pack a pointer of packet structure.
+ * @param info a pointer of summary information structure.
+ */
+void nmea_pack_info(int ptype, void *pack, nmea_info_t *info)
+{
+    switch (ptype)
+    {
+    case GPGGA:
+        nmea_gga_info((nmea_gga_t *)pack, info);
+        break;
+    case GPGSA:
+        nmea_gsa_info((nmea_gsa_t *)pack, info);
+        break;
+    case GPGSV:
+        nmea_gsv_info((nmea_gsv_t *)pack, info);
+        break;
+    case GPRMC:
+        nmea_rmc_info((nmea_rmc_t *)pack, info);
+        break;
+    case GPVTG:
+        nmea_vtg_info((nmea_vtg_t *)pack, info);
+        break;
+    case GPGLL:
+        nmea_gll_info((nmea_gll_t *)pack, info);
+        break;
+    case GPZDA:
+        nmea_zda_info((nmea_zda_t *)pack, info);
+        break;
+    case GPGST:
+        nmea_gst_info((nmea_gst_t *)pack, info);
+        break;
+    case GPGNS:
+        nmea_gns_info((nmea_gns_t *)pack, info);
+        break;
+    case GPGRS:
+        nmea_grs_info((nmea_grs_t *)pack, info);
+        break;
+    case GPDTM:
+        nmea_dtm_info((nmea_dtm_t *)pack, info);
+        break;
+    case GPHDT:
+        nmea_hdt_info((nmea_hdt_t *)pack, info);
+        break;
+    };
+}
+
+/**
+ * \brief Analysis of buffer and put results to information structure
+ * @return Number of packets wos parsed
+ */
+int nmea_parse(
+    nmea_parser_t *parser,
+    const char *buff, int buff_sz,
+    nmea_info_t *info
+)
+{
+    int ptype, nread = 0;
+    void *pack = 0;
+
+    NMEA_ASSERT(parser && parser->buffer);
+
+    nmea_parser_push(parser, buff, buff_sz);
+
+    while (GPNON != (ptype = nmea_parser_pop(parser, &pack)))
+    {
+        nread++;
+        nmea_pack_info(ptype, pack, info);
+#ifdef NMEA_USING_PACK_POOL
+        rt_mp_free(rt_container_of(pack, nmea_parser_node_t, storage));
+#else
+        rt_free(pack);
+#endif
+    }
+
+    return nread;
+}
+
+/**
+ * \brief Set callback of stream mode
+ * @param handler callback called for every parsed packet, RT_NULL to remove
+ * @param user_data user data passed to callback
+ * @see nmea_parse_stream
+ */
+void nmea_parser_set_handler(
+    nmea_parser_t *parser,
+    nmea_pack_handler_t handler,
+    void *user_data
+)
+{
+    NMEA_ASSERT(parser);
+    parser->handler = handler;
+    parser->user_data = user_data;
+}
+
+/**
+ * Callback of view mode with its user data, context of view sink
+ */
+typedef struct _nmea_view_sink_ctx
+{
+    nmea_view_handler_t handler;
+    void *user_data;
+} nmea_view_sink_ctx_t;
+
+/**
+ * \brief Build view of sentence of parser cache
+ * @return Non zero - success or 0 - format error
+ */
+static int nmea_parser_view(
+    nmea_parser_t *parser,
+    const char *buff, int buff_sz,
+    nmea_sentence_view_t *view
+)
+{
+    nmea_framer_t *fr = &parser->framer;
+
+    /* separators found by framing belong to the sentence only if it was just published */
+    if (fr->indexed && fr->len == buff_sz && fr->field_count < NMEA_MAX_FIELDS)
+        return nmea_view_index(view, buff, buff_sz, fr->field_off, fr->field_count);
+
+    return nmea_view_init(view, buff, buff_sz);
+}
+
+/**
+ * \brief Build view of sentence and hand it to callback (sink of view mode)
+ */
+static int nmea_parser_view_sink(
+    nmea_parser_t *parser, int ptype,
+    const char *buff, int buff_sz,
+    void *ctx
+)
+{
+    nmea_sentence_view_t view;
+    nmea_view_sink_ctx_t *cb = (nmea_view_sink_ctx_t *)ctx;
+
+    if (!nmea_parser_view(parser, buff, buff_sz, &view))
+        return 0;
+
+    cb->handler(&view, cb->user_data);
+
+    return 1;
+}
+
+/**
+ * \brief Pass sentence of unknown type to its registered handler
+ */
+static void nmea_parser_prop_dispatch(nmea_parser_t *parser, const char *buff, int buff_sz)
+{
+    const nmea_prop_entry_t *entry;
+    nmea_sentence_view_t view;
+
+    entry = nmea_prop_find(&parser->prop, buff + 1, buff_sz - 1);
+    if (!entry || !nmea_parser_view(parser, buff, buff_sz, &view))
+        return;
+
+    parser->prop_count++;
+    entry->handler(&view, entry->user_data);
+}
+
+/**
+ * \brief Analysis of buffer in view mode: fields of sentences are not
+ * decoded, callback reads the ones it needs by nmea_view_get_xxx().
+ * Sentences of any type are passed, proprietary ones too.
+ * @return Number of sentences was passed to callback
+ */
+int nmea_parse_view(
+    nmea_parser_t *parser,
+    const char *buff, int buff_sz,
+    nmea_view_handler_t handler, void *user_data
+)
+{
+    nmea_view_sink_ctx_t cb;
+
+    NMEA_ASSERT(parser && parser->buffer && handler);
+
+    cb.handler = handler;
+    cb.user_data = user_data;
+
+    return nmea_parser_push_sink(parser, buff, buff_sz, nmea_parser_view_sink, &cb);
+}
+
+#ifdef NMEA_USING_UBX
+/**
+ * \brief Set callback of UBX frames. Frames of UBX protocol interleaved
+ * with sentences are taken out of stream by framing in every parse mode,
+ * they are passed to callback if it is set and dropped otherwise.
+ * @param handler callback called for every UBX frame with right checksum, RT_NULL to remove
+ * @param user_data user data passed to callback
+ * @see nmea_ubx_info_handler
+ */
+void nmea_parser_set_ubx_handler(nmea_parser_t *parser, nmea_ubx_handler_t handler, void *user_data)
+{
+    NMEA_ASSERT(parser);
+    parser->ubx_handler = handler;
+    parser->ubx_user_data = user_data;
+}
+#endif
+
+#ifdef NMEA_USING_RTCM
+/**
+ * \brief Set sink of RTCM3 frames. Correction frames on the same link are
+ * taken out of stream by framing; a frame which is in the buffer given to
+ * parser as a whole is passed straight from there, without copy, during
+ * nmea_parser_feed() too, so sink must fit the context of its caller.
+ * Frames split between buffers are assembled in parser cache.
+ * @param sink callback called for every RTCM3 frame with right CRC, RT_NULL to remove
+ * @param user_data user data passed to sink (e.g. UART device or file)
+ */
+void nmea_parser_set_rtcm_sink(nmea_parser_t *parser, nmea_rtcm_sink_t sink, void *user_data)
+{
+    NMEA_ASSERT(parser);
+    parser->rtcm_sink = sink;
+    parser->rtcm_user_data = user_data;
+}
+#endif
+
+/**
+ * \brief Set packet types to be parsed, sentences of other types are
+ * dropped by framing, before any field is decoded. Unknown types pass.
+ * @param enable_mask mask of packet types (NMEA_PACK_TYPE).
+ * @param fast 1 - drop at address field without checksum check,
+ * 0 - drop after checksum check, so broken sentences are counted as crc_error.
+ */
+void nmea_parser_set_filter(nmea_parser_t *parser, int enable_mask, int fast)
+{
+    NMEA_ASSERT(parser);
+    parser->enable_mask = enable_mask;
+    parser->filter_fast = fast;
+}
+
+/**
+ * \brief Decode packet on stack and hand it to info and callback (sink of stream mode)
+ */
+static int nmea_parser_dispatch(
+    nmea_parser_t *parser, int ptype,
+    const char *buff, int buff_sz,
+    void *ctx
+)
+{
+    nmea_pack_t pack;
+    nmea_info_t *info = (nmea_info_t *)ctx;
+
+    if (!nmea_pack_size(ptype) || !nmea_pack_decode(ptype, buff, buff_sz, &pack))
+        return 0;
+
+    if (info)
+        nmea_pack_info(ptype, &pack, info);
+    if (parser->handler)
+        parser->handler(ptype, &pack, parser->user_data);
+
+    return 1;
+}
+
+/**
+ * \brief Analysis of buffer in stream mode, without any heap allocation.
+ * Every packet is decoded straight into info (if not RT_NULL) and passed
+ * to the callback set by nmea_parser_set_handler(), the packets queue of
+ * parser is not used.
+ * @return Number of packets was parsed
+ */
+int nmea_parse_stream(
+    nmea_parser_t *parser,
+    const char *buff, int buff_sz,
+    nmea_info_t *info
+)
+{
+    NMEA_ASSERT(parser && parser->buffer);
+
+    return nmea_parser_push_sink(parser, buff, buff_sz, nmea_parser_dispatch, info);
+}
+
+/*
+ * low level
+ */
+
+/**
+ * \brief Take a free node for packet of given type
+ * @return Node or RT_NULL if queue is full
+ */
+static nmea_parser_node_t *nmea_parser_node_alloc(nmea_parser_t *parser, int ptype)
+{
+    nmea_parser_node_t *node;
+
+#ifdef NMEA_USING_PACK_POOL
+    /* never wait, parser may work in receive path */
+    node = rt_mp_alloc(&parser->pack_mp, 0);
+    if (node)
+        node->pack = &node->storage;
+#else
+    node = rt_malloc(sizeof(nmea_parser_node_t));
+    if (node && 0 == (node->pack = rt_malloc(nmea_pack_size(ptype))))
+    {
+        rt_free(node);
+        node = RT_NULL;
+    }
+#endif
+
+    return node;
+}
+
+/**
+ * \brief Release node taken by nmea_parser_node_alloc() with its packet
+ */
+static void nmea_parser_node_free(nmea_parser_t *parser, nmea_parser_node_t *node)
+{
+#ifdef NMEA_USING_PACK_POOL
+    rt_mp_free(node);
+#else
+    if (node->pack)
+        rt_free(node->pack);
+    rt_free(node);
+#endif
+}
+
+/**
+ * \brief Put packet into parser queue (sink of queue mode)
+ */
+static int nmea_parser_enqueue(
+    nmea_parser_t *parser, int ptype,
+    const char *buff, int buff_sz,
+    void *ctx
+)
+{
+    nmea_parser_node_t *node = 0;
+
+    if (!nmea_pack_size(ptype))
+        return 0;
+
+    if (0 == (node = nmea_parser_node_alloc(parser, ptype)))
+    {
+        /* keep parsing, the packet is counted as lost */
+        parser->pack_overflow++;
+        return 0;
+    }
+
+    node->packType = ptype;
+    if (!nmea_pack_decode(ptype, buff, buff_sz, (nmea_pack_t *)node->pack))
+    {
+        nmea_parser_node_free(parser, node);
+        return 0;
+    }
+
+    if (parser->end_node)
+        ((nmea_parser_node_t *)parser->end_node)->next_node = node;
+    parser->end_node = node;
+    if (!parser->top_node)
+        parser->top_node = node;
+    node->next_node = 0;
+
+    return 1;
+}
+
+/**
+ * \brief Get index in parser cache of position
+ */
+rt_inline int nmea_parser_buff_index(nmea_parser_t *parser, rt_uint32_t pos)
+{
+    return (pos < (rt_uint32_t)parser->buff_size) ? (int)pos : (int)pos - parser->buff_size;
+}
+
+/**
+ * \brief Move position of parser cache forward
+ */
+rt_inline rt_uint32_t nmea_parser_buff_advance(nmea_parser_t *parser, rt_uint32_t pos, int len)
+{
+    pos += len;
+    if (pos >= 2 * (rt_uint32_t)parser->buff_size)
+        pos -= 2 * parser->buff_size;
+
+    return pos;
+}
+
+/**
+ * \brief Get number of bytes in parser cache. Each position is read once,
+ * so it is consistent even if the other side updates it meanwhile.
+ */
+rt_inline int nmea_parser_buff_len(nmea_parser_t *parser)
+{
+    int len = (int)parser->write_pos - (int)parser->read_pos;
+
+    return (len < 0) ? len + 2 * parser->buff_size : len;
+}
+
+/**
+ * \brief Write byte to parser cache by index relative to the write position.
+ * The head of cache is mirrored behind its end, so every sentence is
+ * contiguous in memory even if it wraps around the end of cache.
+ */
+rt_inline void nmea_parser_buff_set(nmea_parser_t *parser, int idx, char ch)
+{
+    idx += nmea_parser_buff_index(parser, parser->write_pos);
+    if (idx >= parser->buff_size)
+        idx -= parser->buff_size;
+
+    parser->buffer[idx] = (unsigned char)ch;
+    if (idx < NMEA_MAX_FRAME)
+        parser->buffer[parser->buff_size + idx] = (unsigned char)ch;
+}
+
+/**
+ * \brief Add bytes written after the write position to parser cache
+ */
+static void nmea_parser_buff_commit(nmea_parser_t *parser, int len)
+{
+    rt_uint32_t pos = nmea_parser_buff_advance(parser, parser->write_pos, len);
+
+    /* frame and its header must be complete before reader sees new position */
+    NMEA_MEMORY_BARRIER();
+    parser->write_pos = pos;
+}
+
+/**
+ * \brief Remove bytes from the beginning of parser cache
+ */
+static void nmea_parser_buff_skip(nmea_parser_t *parser, int len)
+{
+    rt_uint32_t pos = nmea_parser_buff_advance(parser, parser->read_pos, len);
+
+    /* frame must be read out before writer may reuse its space */
+    NMEA_MEMORY_BARRIER();
+    parser->read_pos = pos;
+}
+
+/**
+ * \brief Get start of current sentence in parser cache, contiguous by mirror
+ */
+rt_inline const char *nmea_parser_buff_sentence(nmea_parser_t *parser)
+{
+    int idx = nmea_parser_buff_index(parser, parser->write_pos) + NMEA_FRAME_HEAD;
+
+    if (idx >= parser->buff_size)
+        idx -= parser->buff_size;
+
+    return (const char *)parser->buffer + idx;
+}
+
+/**
+ * \brief Check that packet type is disabled and count it as dropped
+ * @return 1 - sentence is to be dropped or 0
+ */
+static int nmea_parser_filter(nmea_parser_t *parser, int ptype)
+{
+    int bit;
+
+    if (GPNON == ptype || (ptype & parser->enable_mask))
+        return 0;
+
+    for (bit = 0; !(ptype & (1 << bit)); ++bit)
+        ;
+    parser->filter_drop[bit]++;
+
+    return 1;
+}
+
+/**
+ * \brief Store byte of current sentence into parser cache
+ * @return 0 - success or -1 if sentence does not fit and was dropped
+ */
+rt_inline int nmea_parser_store(nmea_parser_t *parser, char ch)
+{
+    nmea_framer_t *fr = &parser->framer;
+    int max_len = (fr->state >= NMEA_FRAME_UBX_SYNC) ? NMEA_MAX_FRAME : NMEA_MAX_SENTENCE;
+
+    if (fr->len >= max_len ||
+        NMEA_FRAME_HEAD + fr->len + 1 > parser->buff_size - nmea_parser_buff_len(parser))
+    {
+        parser->buff_overflow += fr->len + 1;
+        fr->state = NMEA_FRAME_HUNT;
+        return -1;
+    }
+
+    nmea_parser_buff_set(parser, NMEA_FRAME_HEAD + fr->len++, ch);
+
+    return 0;
+}
+
+/**
+ * \brief Put length header ahead of current frame and publish it
+ * @param flags NMEA_FRAME_UBX, NMEA_FRAME_RTCM or 0 for sentence.
+ */
+rt_inline void nmea_parser_publish(nmea_parser_t *parser, int flags)
+{
+    int head = parser->framer.len | flags;
+
+    nmea_parser_buff_set(parser, 0, (char)(head & 0xFF));
+    nmea_parser_buff_set(parser, 1, (char)(head >> 8));
+    nmea_parser_buff_commit(parser, NMEA_FRAME_HEAD + parser->framer.len);
+}
+
+/**
+ * \brief Convert checksum digit
+ * @return Value of hex digit or -1
+ */
+rt_inline int nmea_hex_digit(char ch)
+{
+    if (ch >= '0' && ch <= '9')
+        return ch - '0';
+    if (ch >= 'A' && ch <= 'F')
+        return ch - 'A' + 10;
+    if (ch >= 'a' && ch <= 'f')
+        return ch - 'a' + 10;
+    return -1;
+}
+
+/**
+ * \brief Pass every complete sentence of parser cache to sink
+ * @param npack a integer pointer for return number of packets produced by sink.
+ * @param published 1 if called right after publish of sentence by framing,
+ * then field offsets of framer may be used for it if it is the only one in cache.
+ * @return Number of sentences was passed or -1 if sink failed
+ */
+static int nmea_parser_drain(
+    nmea_parser_t *parser,
+    nmea_sentence_sink_t sink, void *ctx,
+    int *npack, int published
+)
+{
+    int nsen = 0, sen_sz, ridx, ptype, res;
+    const char *sen;
+
+    while (nmea_parser_buff_len(parser) >= NMEA_FRAME_HEAD)
+    {
+        /* frame is read only after its position was seen */
+        NMEA_MEMORY_BARRIER();
+        ridx = nmea_parser_buff_index(parser, parser->read_pos);
+        sen_sz = parser->buffer[ridx];
+        sen_sz |= parser->buffer[ridx + 1] << 8; /* mirror makes it contiguous */
+
+        ridx += NMEA_FRAME_HEAD;
+        if (ridx >= parser->buff_size)
+            ridx -= parser->buff_size;
+        sen = (const char *)parser->buffer + ridx;
+
+        if (sen_sz & (NMEA_FRAME_UBX | NMEA_FRAME_RTCM))
+        {
+#ifdef NMEA_USING_UBX
+            if ((sen_sz & NMEA_FRAME_UBX) && parser->ubx_handler)
+            {
+                parser->ubx_handler((rt_uint8_t)sen[2] << 8 | (rt_uint8_t)sen[3],
+                    (const rt_uint8_t *)sen + 6, (sen_sz & NMEA_FRAME_LEN_MASK) - NMEA_UBX_FRAME_OVERHEAD,
+                    parser->ubx_user_data);
+            }
+#endif
+#ifdef NMEA_USING_RTCM
+            if ((sen_sz & NMEA_FRAME_RTCM) && parser->rtcm_sink)
+                parser->rtcm_sink((const rt_uint8_t *)sen, sen_sz & NMEA_FRAME_LEN_MASK, parser->rtcm_user_data);
+#endif
+            nmea_parser_buff_skip(parser, NMEA_FRAME_HEAD + (sen_sz & NMEA_FRAME_LEN_MASK));
+            continue;
+        }
+
+        parser->framer.indexed = published && nmea_parser_buff_len(parser) == NMEA_FRAME_HEAD + sen_sz;
+        published = 0;
+
+        ptype = nmea_pack_type(sen + 1, sen_sz - 1);
+        if (GPNON == ptype && parser->prop.count)
+            nmea_parser_prop_dispatch(parser, sen, sen_sz);
+
+        res = sink(parser, ptype, sen, sen_sz, ctx);
+        parser->framer.indexed = 0;
+
+        nmea_parser_buff_skip(parser, NMEA_FRAME_HEAD + sen_sz);
+        nsen++;
+
+        if (res < 0)
+            return -1;
+        *npack += res;
+    }
+
+    return nsen;
+}
+
+/**
+ * \brief Run framing over buffer, byte by byte.
+ * Every byte is looked at once, state is kept in parser->framer between
+ * calls. Complete sentences with right checksum are added to parser cache;
+ * if sink is set, they are passed to it right away.
+ * @return Number of complete sentences or -1 if sink failed
+ */
+static int nmea_parser_feed_sink(
+    nmea_parser_t *parser,
+    const char *buff, int buff_sz,
+    nmea_sentence_sink_t sink, void *ctx,
+    int *npack
+)
+{
+    nmea_framer_t *fr = &parser->framer;
+    const char *end_buff = buff + buff_sz;
+    int nsen = 0, digit;
+    char ch;
+
+    for (; buff < end_buff; ++buff)
+    {
+        ch = *buff;
+
+        switch (fr->state)
+        {
+        case NMEA_FRAME_HUNT:
+            break;
+        case NMEA_FRAME_BODY:
+            if ('*' == ch)
+            {
+                fr->state = NMEA_FRAME_CRC1;
+            }
+            else if ('$' == ch || '\r' == ch || '\n' == ch || ((rt_uint8_t)ch & 0x80))
+            {
+                /* binary frame may start at byte out of ASCII */
+                fr->state = NMEA_FRAME_HUNT;
+                break;
+            }
+            else
+            {
+                fr->crc ^= ch;
+                if (',' == ch && 0 == fr->field_count)
+                {
+                    /* address field is complete, type is known */
+                    fr->ptype = nmea_pack_type(nmea_parser_buff_sentence(parser) + 1, fr->len - 1);
+                    if (parser->filter_fast && nmea_parser_filter(parser, fr->ptype))
+                    {
+                        fr->state = NMEA_FRAME_HUNT;
+                        continue;
+                    }
+                }
+                if (',' == ch && fr->field_count < NMEA_MAX_FIELDS)
+                    fr->field_off[fr->field_count++] = (rt_uint16_t)fr->len;
+            }
+            goto store;
+        case NMEA_FRAME_CRC1:
+        case NMEA_FRAME_CRC2:
+            if ((digit = nmea_hex_digit(ch)) < 0)
+            {
+                fr->state = NMEA_FRAME_HUNT;
+                break;
+            }
+            fr->crc_rx = (fr->crc_rx << 4) | digit;
+            fr->state++;
+            goto store;
+        case NMEA_FRAME_CR:
+            if ('\r' != ch)
+            {
+                fr->state = NMEA_FRAME_HUNT;
+                break;
+            }
+            fr->state = NMEA_FRAME_LF;
+            goto store;
+        case NMEA_FRAME_LF:
+            fr->state = NMEA_FRAME_HUNT;
+            if ('\n' != ch)
+                break;
+            if (nmea_parser_store(parser, ch) < 0)
+                continue;
+
+            if (fr->crc != fr->crc_rx)
+            {
+                parser->crc_error++;
+                continue;
+            }
+
+            if (!parser->filter_fast && nmea_parser_filter(parser, fr->ptype))
+                continue;
+
+            /* sentence is complete, put its length ahead of it and publish */
+            nmea_parser_publish(parser, 0);
+            nsen++;
+
+            if (sink && nmea_parser_drain(parser, sink, ctx, npack, 1) < 0)
+                return -1;
+            continue;
+#ifdef NMEA_USING_UBX
+        case NMEA_FRAME_UBX_SYNC:
+            if (NMEA_UBX_SYNC2 != (rt_uint8_t)ch)
+            {
+                fr->state = NMEA_FRAME_HUNT;
+                break;
+            }
+            fr->state = NMEA_FRAME_UBX_HEAD;
+            goto store;
+        case NMEA_FRAME_UBX_HEAD:
+            /* Fletcher checksum: crc is CK_A, crc_rx is CK_B */
+            fr->crc = (fr->crc + (rt_uint8_t)ch) & 0xFF;
+            fr->crc_rx = (fr->crc_rx + fr->crc) & 0xFF;
+            if (4 == fr->len)
+            {
+                fr->bin_len = (rt_uint8_t)ch;
+            }
+            else if (5 == fr->len)
+            {
+                fr->bin_len |= (rt_uint8_t)ch << 8;
+                if (fr->bin_len > NMEA_UBX_MAX_PAYLOAD)
+                {
+                    parser->buff_overflow += fr->len + 1;
+                    fr->state = NMEA_FRAME_HUNT;
+                    continue;
+                }
+                fr->state = NMEA_FRAME_UBX_BODY;
+            }
+            goto store;
+        case NMEA_FRAME_UBX_BODY:
+            if (fr->len < 6 + fr->bin_len)
+            {
+                fr->crc = (fr->crc + (rt_uint8_t)ch) & 0xFF;
+                fr->crc_rx = (fr->crc_rx + fr->crc) & 0xFF;
+                goto store;
+            }
+
+            /* checksum byte: broken frame is left at it, the byte may start next frame */
+            if ((rt_uint8_t)ch != ((fr->len == 6 + fr->bin_len) ? fr->crc : fr->crc_rx))
+            {
+                parser->ubx_crc_error++;
+                fr->state = NMEA_FRAME_HUNT;
+                break;
+            }
+            if (nmea_parser_store(parser, ch) < 0 || fr->len < NMEA_UBX_FRAME_OVERHEAD + fr->bin_len)
+                continue;
+
+            fr->state = NMEA_FRAME_HUNT;
+            parser->ubx_count++;
+            nmea_parser_publish(parser, NMEA_FRAME_UBX);
+
+            if (sink && nmea_parser_drain(parser, sink, ctx, npack, 0) < 0)
+                return -1;
+            continue;
+#endif
+#ifdef NMEA_USING_RTCM
+        case NMEA_FRAME_RTCM_HEAD:
+            if (1 == fr->len && ((rt_uint8_t)ch & 0xFC))
+            {
+                fr->state = NMEA_FRAME_HUNT;
+                break;
+            }
+            fr->crc = (int)nmea_crc24q((rt_uint32_t)fr->crc, (const rt_uint8_t *)buff, 1);
+            fr->bin_len = ((fr->bin_len << 8) | (rt_uint8_t)ch) & 0x3FF;
+            if (2 == fr->len)
+            {
+                if (fr->bin_len > NMEA_RTCM_MAX_PAYLOAD)
+                {
+                    parser->buff_overflow += fr->len + 1;
+                    fr->state = NMEA_FRAME_HUNT;
+                    continue;
+                }
+                fr->state = NMEA_FRAME_RTCM_BODY;
+            }
+            goto store;
+        case NMEA_FRAME_RTCM_BODY:
+            if (fr->len < 3 + fr->bin_len)
+            {
+                fr->crc = (int)nmea_crc24q((rt_uint32_t)fr->crc, (const rt_uint8_t *)buff, 1);
+                goto store;
+            }
+
+            fr->crc_rx = (fr->crc_rx << 8) | (rt_uint8_t)ch;
+            if (nmea_parser_store(parser, ch) < 0 || fr->len < NMEA_RTCM_FRAME_SIZE(fr->bin_len))
+                continue;
+
+            fr->state = NMEA_FRAME_HUNT;
+            if (fr->crc != fr->crc_rx)
+            {
+                parser->rtcm_crc_error++;
+                continue;
+            }
+            parser->rtcm_count++;
+            nmea_parser_publish(parser, NMEA_FRAME_RTCM);
+
+            if (sink && nmea_parser_drain(parser, sink, ctx, npack, 0) < 0)
+                return -1;
+            continue;
+#endif
+        }
+
+        /* HUNT state or broken sentence: look for start of next one */
+        if ('$' == ch)
+        {
+            fr->state = NMEA_FRAME_BODY;
+            fr->len = 0;
+            fr->crc = 0;
+            fr->crc_rx = 0;
+            fr->ptype = GPNON;
+            fr->field_count = 0;
+        }
+#ifdef NMEA_USING_UBX
+        else if (NMEA_UBX_SYNC1 == (rt_uint8_t)ch)
+        {
+            /* frame of binary protocol, fields are not indexed */
+            fr->state = NMEA_FRAME_UBX_SYNC;
+            fr->len = 0;
+            fr->crc = 0;
+            fr->crc_rx = 0;
+            fr->ptype = GPNON;
+            fr->field_count = NMEA_MAX_FIELDS;
+        }
+#endif
+#ifdef NMEA_USING_RTCM
+        else if (NMEA_RTCM_PREAMBLE == (rt_uint8_t)ch)
+        {
+            int nread;
+
+            /* frame which is in buffer as a whole goes to sink right from there */
+            nread = nmea_rtcm_frame((const rt_uint8_t *)buff, (int)(end_buff - buff));
+            if (nread > 0)
+            {
+                parser->rtcm_count++;
+                parser->rtcm_direct++;
+                if (parser->rtcm_sink)
+                    parser->rtcm_sink((const rt_uint8_t *)buff, nread, parser->rtcm_user_data);
+                buff += nread - 1;
+                continue;
+            }
+            if (nread < 0)
+            {
+                if (-2 == nread)
+                    parser->rtcm_crc_error++;
+                continue;
+            }
+
+            /* frame goes on in next buffer, it is assembled in cache */
+            fr->state = NMEA_FRAME_RTCM_HEAD;
+            fr->len = 0;
+            fr->crc = (int)nmea_crc24q(0, (const rt_uint8_t *)buff, 1);
+            fr->crc_rx = 0;
+            fr->bin_len = 0;
+            fr->ptype = GPNON;
+            fr->field_count = NMEA_MAX_FIELDS;
+        }
+#endif
+        else
+        {
+            continue;
+        }
+
+store:
+        nmea_parser_store(parser, ch);
+    }
+
+    return nsen;
+}
+
+/**
+ * \brief Put received bytes into parser, without parsing them.
+ * Does not allocate memory nor block, may be called from UART receive
+ * interrupt or DMA callback, while nmea_parser_poll() runs in thread:
+ * each side publishes its own position of parser cache by single store.
+ * Must not be used together with nmea_parse() or nmea_parse_stream() on
+ * the same parser.
+ * @return Number of complete sentences added to parser cache
+ * @see nmea_parser_poll
+ */
+int nmea_parser_feed(nmea_parser_t *parser, const char *buff, int buff_sz)
+{
+    NMEA_ASSERT(parser && parser->buffer && buff);
+
+    return nmea_parser_feed_sink(parser, buff, buff_sz, RT_NULL, RT_NULL, RT_NULL);
+}
+
+/**
+ * \brief Parse sentences added by nmea_parser_feed() in stream mode,
+ * called from thread context.
+ * @return Number of packets was parsed
+ * @see nmea_parse_stream
+ */
+int nmea_parser_poll(nmea_parser_t *parser, nmea_info_t *info)
+{
+    int npack = 0;
+
+    NMEA_ASSERT(parser && parser->buffer);
+
+    nmea_parser_drain(parser, nmea_parser_dispatch, info, &npack, 0);
+
+    return npack;
+}
+
+/**
+ * \brief Analysis of buffer through parser cache
+ * @return Number of packets produced by sink
+ */
+static int nmea_parser_push_sink(
+    nmea_parser_t *parser,
+    const char *buff, int buff_sz,
+    nmea_sentence_sink_t sink, void *ctx
+)
+{
+    int npack = 0;
+
+    nmea_parser_feed_sink(parser, buff, buff_sz, sink, ctx, &npack);
+
+    return npack;
+}
+
+int nmea_parser_real_push(nmea_parser_t *parser, const char *buff, int buff_sz)
+{
+    return nmea_parser_push_sink(parser, buff, buff_sz, nmea_parser_enqueue, RT_NULL);
+}
+
+/**
+ * \brief Analysis of buffer and keep results into parser
+ * @return Number of packets was put into queue
+ */
+static int nmea_parser_push(nmea_parser_t *parser, const char *buff, int buff_sz)
+{
+    return nmea_parser_real_push(parser, buff, buff_sz);
+}
+
+/**
+ * \brief Get type of top packet keeped into parser
+ * @return Type of packet
+ * @see NMEA_PACK_TYPE
+ */
+int nmea_parser_top(nmea_parser_t *parser)
+{
+    int retval = GPNON;
+    nmea_parser_node_t *node = (nmea_parser_node_t *)parser->top_node;
+
+    NMEA_ASSERT(parser && parser->buffer);
+
+    if (node)
+        retval = node->packType;
+
+    return retval;
+}
+
+/**
+ * \brief Withdraw top packet from parser
+ * @return Received packet type
+ * @see NMEA_PACK_TYPE
+ */
+static int nmea_parser_pop(nmea_parser_t *parser, void **pack_ptr)
+{
+    int retval = GPNON;
+    nmea_parser_node_t *node = (nmea_parser_node_t *)parser->top_node;
+
+    NMEA_ASSERT(parser && parser->buffer);
+
+    if (node)
+    {
+        *pack_ptr = node->pack;
+        retval = node->packType;
+        parser->top_node = node->next_node;
+        if (!parser->top_node)
+            parser->end_node = 0;
+#ifndef NMEA_USING_PACK_POOL
+        /* with pool the packet lives inside node, it is released with packet */
+        rt_free(node);
+#endif
+    }
+
+    return retval;
+}
+
+/**
+ * \brief Get top packet from parser without withdraw
+ * @return Received packet type
+ * @see NMEA_PACK_TYPE
+ */
+int nmea_parser_peek(nmea_parser_t *parser, void **pack_ptr)
+{
+    int retval = GPNON;
+    nmea_parser_node_t *node = (nmea_parser_node_t *)parser->top_node;
+
+    NMEA_ASSERT(parser && parser->buffer);
+
+    if (node)
+    {
+        *pack_ptr = node->pack;
+        retval = node->packType;
+    }
+
+    return retval;
+}
+
+/**
+ * \brief Delete top packet from parser
+ * @return Deleted packet type
+ * @see NMEA_PACK_TYPE
+ */
+int nmea_parser_drop(nmea_parser_t *parser)
+{
+    int retval = GPNON;
+    nmea_parser_node_t *node = (nmea_parser_node_t *)parser->top_node;
+
+    NMEA_ASSERT(parser && parser->buffer);
+
+    if (node)
+    {
+        retval = node->packType;
+        parser->top_node = node->next_node;
+        if (!parser->top_node)
+            parser->end_node = 0;
+        nmea_parser_node_free(parser, node);
+    }
+
+    return retval;
+}
+
+/**
+ * \brief Clear packets queue into parser
+ * @return true (1) - success
+ */
+static int nmea_parser_queue_clear(nmea_parser_t *parser)
+{
+    NMEA_ASSERT(parser);
+    while (parser->top_node)
+        nmea_parser_drop(parser);
+    return 1;
+}
+
+/**
+ * \brief Analyse string (specificate for NMEA sentences)
+ */
+int nmea_scanf(const char *buff, int buff_sz, const char *format, ...)
+{
+    const char *beg_tok;
+    const char *end_buf = buff + buff_sz;
+
+    va_list arg_ptr;
+    int tok_type = NMEA_TOKS_COMPARE;
+    int width = 0;
+    const char *beg_fmt = 0;
+    int snum = 0, unum = 0;
+
+    int tok_count = 0;
+    void *parg_target;
+
+    va_start(arg_ptr, format);
+
+    for (; *format && buff < end_buf; ++format)
+    {
+        switch (tok_type)
+        {
+        case NMEA_TOKS_COMPARE:
+            if ('%' == *format)
+                tok_type = NMEA_TOKS_PERCENT;
+            else if (*buff++ != *format)
+                goto fail;
+            break;
+        case NMEA_TOKS_PERCENT:
+            width = 0;
+            beg_fmt = format;
+            tok_type = NMEA_TOKS_WIDTH;
+        case NMEA_TOKS_WIDTH:
+            if (isdigit(*format))
+                break;
+            {
+                tok_type = NMEA_TOKS_TYPE;
+                if (format > beg_fmt)
+                    width = nmea_atoi(beg_fmt, (int)(format - beg_fmt), 10);
+            }
+        case NMEA_TOKS_TYPE:
+            beg_tok = buff;
+
+            if (!width && ('c' == *format || 'C' == *format) && *buff != format[1])
+                width = 1;
+
+            if (width)
+            {
+                if (buff + width <= end_buf)
+                    buff += width;
+                else
+                    goto fail;
+            }
+            else
+            {
+                if (!format[1] || (0 == (buff = (char *)memchr(buff, format[1], end_buf - buff))))
+                    buff = end_buf;
+            }
+
+            if (buff > end_buf)
+                goto fail;
+
+            tok_type = NMEA_TOKS_COMPARE;
+            tok_count++;
+
+            parg_target = 0; width = (int)(buff - beg_tok);
+
+            switch (*format)
+            {
+            case 'c':
+            case 'C':
+                parg_target = (void *)va_arg(arg_ptr, char *);
+                if (width && 0 != (parg_target))
+                    *((char *)parg_target) = *beg_tok;
+                break;
+            case 's':
+            case 'S':
+                parg_target = (void *)va_arg(arg_ptr, char *);
+                if (width && 0 != (parg_target))
+                {
+                    rt_memcpy(parg_target, beg_tok, width);
+                    ((char *)parg_target)[width] = '\0';
+                }
+                break;
+            case 'f':
+            case 'g':
+            case 'G':
+            case 'e':
+            case 'E':
+                parg_target = (void *)va_arg(arg_ptr, double *);
+                if (width && 0 != (parg_target))
+                    *((double *)parg_target) = nmea_atof(beg_tok, width);
+                break;
+            };
+
+            if (parg_target)
+                break;
+            if (0 == (parg_target = (void *)va_arg(arg_ptr, int *)))
+                break;
+            if (!width)
+                break;
+
+            switch (*format)
+            {
+            case 'd':
+            case 'i':
+                snum = nmea_atoi(beg_tok, width, 10);
+                rt_memcpy(parg_target, &snum, sizeof(int));
+                break;
+            case 'u':
+                unum = nmea_atoi(beg_tok, width, 10);
+                rt_memcpy(parg_target, &unum, sizeof(unsigned int));
+                break;
+            case 'x':
+            case 'X':
+                unum = nmea_atoi(beg_tok, width, 16);
+                rt_memcpy(parg_target, &unum, sizeof(unsigned int));
+                break;
+            case 'o':
+                unum = nmea_atoi(beg_tok, width, 8);
+                rt_memcpy(parg_target, &unum, sizeof(unsigned int));
+                break;
+            default:
+                goto fail;
+            };
+
+            break;
+        };
+    }
+
+fail:
+
+    va_end(arg_ptr);
+
+    return tok_count;
+}
@@ -0,0 +1,1031 @@
+#ifndef __NMEA_PARSE_H__
+#define __NMEA_PARSE_H__
+
+#include <rtthread.h>
+
+#ifdef  __cplusplus
+extern "C" {
+#endif
+
+#define NMEA_SIG_BAD            (0)
+#define NMEA_SIG_LOW            (1)
+#define NMEA_SIG_MID            (2)
+#define NMEA_SIG_HIGH           (3)
+
+#define NMEA_FIX_BAD            (1)
+#define NMEA_FIX_2D             (2)
+#define NMEA_FIX_3D             (3)
+
+#define NMEA_MAXSAT             (12)
+#define NMEA_SATINPACK          (4)
+#define NMEA_NSATPACKS          (NMEA_MAXSAT / NMEA_SATINPACK)
+
+#define NMEA_CONVSTR_BUF        (256)
+#define NMEA_TIMEPARSE_BUF      (256)
+
+#define NMEA_LEAP_SECONDS_AUTO  (-1) /**< GPS - UTC offset from built-in table */
+
+#define NMEA_DEF_PARSEBUFF      (1024)
+#define NMEA_MIN_PARSEBUFF      (256)
+#define NMEA_MAX_SENTENCE       (256) /**< Max length of sentence */
+#define NMEA_MAX_FIELDS         (32)  /**< Max number of fields indexed by framer */
+
+#ifndef NMEA_SAT_TABLE_SIZE
+#define NMEA_SAT_TABLE_SIZE     (64) /**< Capacity of satellites table, power of two */
+#endif
+#define NMEA_SAT_SIGNAL_COUNT   (16) /**< Number of signal IDs kept by satellites table */
+
+#ifndef NMEA_PACK_POOL_SIZE
+#define NMEA_PACK_POOL_SIZE     (16) /**< Max number of packets in parser queue */
+#endif
+
+#define NMEA_TUD_KNOTS          (1.852) /**< Knots, kilometer / NMEA_TUD_KNOTS = knot */
+
+#define NMEA_ASSERT             RT_ASSERT
+#define nmea_error              rt_kprintf
+
+#define NMEA_PACK_TYPE_COUNT    (12) /**< Number of packet types (bits of NMEA_PACK_TYPE) */
+#define NMEA_PACK_TYPE_ALL      (0x0FFF) /**< Mask of all packet types */
+
+#define NMEA_FIELD_STR_SIZE     (8) /**< Size of text field storage (GNS mode, DTM datum), with terminating zero */
+
+#define NMEA_FIX_READ_RETRY     (8) /**< Attempts of nmea_fix_read() while writer publishes */
+
+#ifndef NMEA_PARALLEL_MAX_THREADS
+#define NMEA_PARALLEL_MAX_THREADS (4) /**< Max number of threads of nmea_parse_parallel() */
+#endif
+#define NMEA_PARALLEL_STACK_SIZE (4096)
+
+#ifndef NMEA_GSV_MAX_SAT
+#define NMEA_GSV_MAX_SAT        (32) /**< Max number of satellites of one GSV cycle kept by assembler */
+#endif
+#ifndef NMEA_GSV_MAX_STREAMS
+#define NMEA_GSV_MAX_STREAMS    (8)  /**< Max number of talker/signal pairs tracked by GSV assembler */
+#endif
+#define NMEA_GSV_MAX_PACKS      ((NMEA_GSV_MAX_SAT + NMEA_SATINPACK - 1) / NMEA_SATINPACK)
+
+#if (NMEA_GSV_MAX_PACKS > 32)
+#error "NMEA_GSV_MAX_SAT is too big for fragment bitmap"
+#endif
+
+#ifndef NMEA_PROP_MAX_HANDLERS
+#define NMEA_PROP_MAX_HANDLERS  (8)  /**< Max number of proprietary sentence handlers of parser */
+#endif
+#define NMEA_PROP_PREFIX_SIZE   (12) /**< Max size of handler prefix, with terminating zero */
+#define NMEA_PROP_KEY_SIZE      (4)  /**< Characters of prefix hashed to bucket ("PUBX", "PMTK", "GNEP") */
+#define NMEA_PROP_HASH_BITS     (4)
+#define NMEA_PROP_HASH_SIZE     (1 << NMEA_PROP_HASH_BITS)
+
+#if (NMEA_PROP_MAX_HANDLERS > 255)
+#error "NMEA_PROP_MAX_HANDLERS is too big for bucket index"
+#endif
+
+#ifndef NMEA_UBX_MAX_PAYLOAD
+#define NMEA_UBX_MAX_PAYLOAD    (512) /**< Max payload of UBX frame kept by parser, NAV-SAT is 8 + 12 by satellite */
+#endif
+#define NMEA_UBX_FRAME_OVERHEAD (8)   /**< Sync, class, ID, length and checksum of UBX frame */
+
+#define NMEA_UBX_NAV_PVT        (0x0107) /**< NAV-PVT message (class << 8 | ID), navigation solution */
+#define NMEA_UBX_NAV_SAT        (0x0135) /**< NAV-SAT message, satellites information */
+#define NMEA_UBX_NAV_PVT_SIZE   (92)     /**< Payload size of NAV-PVT */
+
+#ifndef NMEA_RTCM_MAX_PAYLOAD
+#define NMEA_RTCM_MAX_PAYLOAD   (1023) /**< Max payload of RTCM3 frame assembled in parser cache */
+#endif
+#define NMEA_RTCM_PREAMBLE      (0xD3)
+#define NMEA_RTCM_FRAME_SIZE(payload_sz) ((payload_sz) + 6) /**< Preamble, length, payload and CRC-24Q */
+
+#if (NMEA_RTCM_MAX_PAYLOAD > 1023)
+#error "NMEA_RTCM_MAX_PAYLOAD is more than RTCM3 length field allows"
+#endif
+
+/* the longest frame of parser cache, it is kept contiguous by mirror of cache head */
+#if defined(NMEA_USING_UBX) && (NMEA_UBX_MAX_PAYLOAD + NMEA_UBX_FRAME_OVERHEAD > NMEA_MAX_SENTENCE)
+#define NMEA_MAX_BIN_FRAME      (NMEA_UBX_MAX_PAYLOAD + NMEA_UBX_FRAME_OVERHEAD)
+#else
+#define NMEA_MAX_BIN_FRAME      NMEA_MAX_SENTENCE
+#endif
+#if defined(NMEA_USING_RTCM) && (NMEA_RTCM_FRAME_SIZE(NMEA_RTCM_MAX_PAYLOAD) > NMEA_MAX_BIN_FRAME)
+#define NMEA_MAX_FRAME          NMEA_RTCM_FRAME_SIZE(NMEA_RTCM_MAX_PAYLOAD)
+#else
+#define NMEA_MAX_FRAME          NMEA_MAX_BIN_FRAME
+#endif
+
+/** Hardware and compiler memory barrier, orders fix publication */
+#if defined(__ARMCC_VERSION)            /* ARM Compiler */
+#if (__ARMCC_VERSION >= 6000000)
+#include <arm_acle.h>
+#endif
+#define NMEA_MEMORY_BARRIER()   __dmb(0xF)
+#elif defined (__IAR_SYSTEMS_ICC__)     /* for IAR Compiler */
+#define NMEA_MEMORY_BARRIER()   __asm volatile ("dmb" ::: "memory")
+#elif defined (__GNUC__)                /* GNU GCC Compiler */
+#define NMEA_MEMORY_BARRIER()   __sync_synchronize()
+#elif defined (_MSC_VER)
+#include <intrin.h>
+#define NMEA_MEMORY_BARRIER()   _ReadWriteBarrier()
+#else
+#error "NMEA_MEMORY_BARRIER is not defined for this compiler"
+#endif
+
+#if defined(NMEA_USING_FIXED_POINT) && defined(NMEA_USING_SCANF_DECODER)
+#error "NMEA_USING_FIXED_POINT requires compiled decoders, disable NMEA_USING_SCANF_DECODER"
+#endif
+
+#ifdef NMEA_USING_FIXED_POINT
+#define NMEA_COORD_SCALE        (10000000) /**< Coordinates in 1e-7 degrees */
+#define NMEA_DIST_SCALE         (1000)     /**< Altitude and distances in millimetres */
+#define NMEA_CENTI_SCALE        (100)      /**< DOP, speed, angles and seconds in hundredths */
+
+typedef rt_int32_t  nmea_coord_t;   /**< Latitude or longitude, degrees * NMEA_COORD_SCALE */
+typedef rt_int32_t  nmea_dist_t;    /**< Altitude or distance, meters * NMEA_DIST_SCALE */
+typedef rt_int32_t  nmea_centi_t;   /**< DOP, speed, angle or time, value * NMEA_CENTI_SCALE */
+#else
+typedef double      nmea_coord_t;   /**< Latitude or longitude in NDEG - [degree][min].[sec/60] */
+typedef double      nmea_dist_t;    /**< Altitude or distance in meters */
+typedef double      nmea_centi_t;   /**< DOP, speed, angle or time */
+#endif
+
+/**
+ * Date and time data
+ * @see nmea_time_now
+ */
+typedef struct _nmea_time
+{
+    int year; /**< Years since 1900 */
+    int mon; /**< Months since January - [0,11] */
+    int day; /**< Day of the month - [1,31] */
+    int hour; /**< Hours since midnight - [0,23] */
+    int min; /**< Minutes after the hour - [0,59] */
+    int sec; /**< Seconds after the minute - [0,59] */
+    int hsec; /**< Hundredth part of second - [0,99] */
+} nmea_time_t;
+
+/**
+ * Information about satellite
+ * @see nmeaSATINFO
+ * @see nmea_gsv_t
+ */
+typedef struct _nmea_satellite
+{
+    int     id;         /**< Satellite PRN number */
+    int     in_use;     /**< Used in position fix */
+    int     elv;        /**< Elevation in degrees, 90 maximum */
+    int     azimuth;    /**< Azimuth, degrees from true north, 000 to 359 */
+    int     sig;        /**< Signal, 00-99 dB */
+} nmea_satellite_t;
+
+/**
+ * Information about all satellites in view
+ * @see nmea_info_t
+ * @see nmea_gsv_t
+ */
+typedef struct _nmea_sta_info
+{
+    int     inuse; /**< Number of satellites in use (not those in view) */
+    int     inview; /**< Total number of satellites in view */
+    nmea_satellite_t sat[NMEA_MAXSAT]; /**< Satellites information */
+} nmea_sat_info_t;
+
+/**
+ * GNSS system ID (NMEA 4.10 system ID of GSA, GSV and GNS sentences)
+ * @see nmea_sat_system
+ */
+enum NMEA_SYSTEM
+{
+    NMEA_SYSTEM_NON = 0,    /**< Unknown system */
+    NMEA_SYSTEM_GPS,        /**< GPS and SBAS */
+    NMEA_SYSTEM_GLONASS,    /**< GLONASS */
+    NMEA_SYSTEM_GALILEO,    /**< Galileo */
+    NMEA_SYSTEM_BEIDOU,     /**< BeiDou */
+    NMEA_SYSTEM_QZSS,       /**< QZSS */
+    NMEA_SYSTEM_NAVIC,      /**< NavIC (IRNSS) */
+    NMEA_SYSTEM_MAX
+};
+
+/**
+ * Satellite in table, keyed by (system, prn, signal)
+ * @see nmea_sat_table_t
+ */
+typedef struct _nmea_sat_entry
+{
+    rt_uint16_t prn;        /**< Satellite PRN number, 0 - free entry */
+    rt_uint8_t  system;     /**< GNSS system (NMEA_SYSTEM) */
+    rt_uint8_t  signal;     /**< Signal ID, 0 - not reported */
+    rt_uint16_t azimuth;    /**< Azimuth, degrees from true north, 000 to 359 */
+    rt_int8_t   elv;        /**< Elevation in degrees, 90 maximum */
+    rt_uint8_t  sig;        /**< Signal, 00-99 dB */
+    rt_uint8_t  seen_gen;   /**< GSV cycle of signal the satellite was reported in */
+    rt_uint8_t  used_gen;   /**< GSA of system the satellite was used in, 0 - never */
+} nmea_sat_entry_t;
+
+/**
+ * Satellites of all systems, open addressing hash table.
+ * GSA marks satellites in use by generation counter of the system,
+ * so previous marks are dropped without walking the table. GSV cycles
+ * are counted by signal of system. Entries are rebased when a counter wraps.
+ * @see nmea_info_t
+ */
+typedef struct _nmea_sat_table
+{
+    int         count;      /**< Number of used entries */
+    rt_uint32_t overflow;   /**< Number of satellites was not stored, table is full */
+    rt_uint8_t  seen_gen[NMEA_SYSTEM_MAX][NMEA_SAT_SIGNAL_COUNT]; /**< Current GSV cycle by system and signal */
+    rt_uint8_t  used_gen[NMEA_SYSTEM_MAX]; /**< Current GSA by system, 0 - no GSA yet */
+    rt_uint8_t  view_count[NMEA_SYSTEM_MAX][NMEA_SAT_SIGNAL_COUNT]; /**< Satellites of current GSV cycle by system and signal */
+    rt_uint8_t  used_count[NMEA_SYSTEM_MAX]; /**< Satellites of last GSA by system */
+    rt_uint16_t signals[NMEA_SYSTEM_MAX];  /**< Mask of signal IDs seen by system */
+    rt_uint16_t cycle_systems; /**< Mask of systems (1 << NMEA_SYSTEM) already seen by current GSV cycle */
+    int         cycle_index;   /**< Message number of last GSV */
+    nmea_sat_entry_t sat[NMEA_SAT_TABLE_SIZE];
+} nmea_sat_table_t;
+
+/**
+ * Summary GPS information from all parsed packets,
+ * used also for generating NMEA stream
+ * @see nmea_parse
+ * @see nmea_gga_info,  nmea_...info
+ */
+typedef struct _nmea_info
+{
+    int     smask; /**< Mask specifying types of packages from which data have been obtained */
+
+    nmea_time_t utc; /**< UTC of position */
+
+    int     sig; /**< GPS quality indicator (0 = Invalid; 1 = Fix; 2 = Differential, 3 = Sensitive) */
+    int     fix; /**< Operating mode, used for navigation (1 = Fix not available; 2 = 2D; 3 = 3D) */
+
+    nmea_centi_t PDOP; /**< Position Dilution Of Precision */
+    nmea_centi_t HDOP; /**< Horizontal Dilution Of Precision */
+    nmea_centi_t VDOP; /**< Vertical Dilution Of Precision */
+
+    nmea_coord_t lat; /**< Latitude (nmea_coord_t) - +/-[degree][min].[sec/60] */
+    nmea_coord_t lon; /**< Longitude (nmea_coord_t) - +/-[degree][min].[sec/60] */
+    nmea_dist_t elv; /**< Antenna altitude above/below mean sea level (geoid) in meters */
+    nmea_centi_t speed; /**< Speed over the ground in kilometers/hour */
+    nmea_centi_t direction; /**< Track angle in degrees True */
+    nmea_centi_t declination; /**< Magnetic variation degrees (Easterly var. subtracts from true course) */
+    nmea_centi_t heading; /**< True heading in degrees (HDT) */
+
+    nmea_dist_t rms; /**< RMS of pseudorange residuals in meters (GST) */
+    nmea_dist_t err_major; /**< Semi-major axis of error ellipse in meters (GST) */
+    nmea_dist_t err_minor; /**< Semi-minor axis of error ellipse in meters (GST) */
+    nmea_centi_t err_orient; /**< Orientation of semi-major axis in degrees from true north (GST) */
+    nmea_dist_t lat_err; /**< Standard deviation of latitude error in meters (GST) */
+    nmea_dist_t lon_err; /**< Standard deviation of longitude error in meters (GST) */
+    nmea_dist_t elv_err; /**< Standard deviation of altitude error in meters (GST) */
+
+    int     zone_min; /**< Local time zone, minutes from UTC (ZDA) */
+    char    datum[NMEA_FIELD_STR_SIZE]; /**< Local datum code of position (DTM), "W84" - WGS-84 */
+
+    nmea_sat_info_t satinfo; /**< Satellites information */
+    nmea_sat_table_t *sattab; /**< Optional satellites table of all systems, updated by GSV and GSA if set;
+                                   then satinfo has only totals of all systems, satellites are in table */
+} nmea_info_t;
+
+/**
+ * Callback of stream mode, called for every packet parsed by library
+ * @param ptype packet type (NMEA_PACK_TYPE)
+ * @param pack a pointer of packet structure, valid only during the call
+ * @param user_data user data registered with handler
+ * @see nmea_parser_set_handler
+ */
+typedef void (*nmea_pack_handler_t)(int ptype, void *pack, void *user_data);
+
+/**
+ * Raw view of sentence: only positions of fields are indexed, values
+ * are decoded by nmea_view_get_xxx() when caller reads them. Field 0 is
+ * address field, fields 1..field_count follow it.
+ * @see nmea_view_init
+ */
+typedef struct _nmea_sentence_view
+{
+    const char *buff;       /**< Sentence from '$', not copied */
+    int         buff_sz;
+    int         ptype;      /**< Packet type (NMEA_PACK_TYPE), GPNON for other sentences */
+    int         field_count; /**< Number of fields after address field */
+    rt_uint16_t field_off[NMEA_MAX_FIELDS + 1]; /**< Offsets of ',' separators and of '*' from '$' */
+} nmea_sentence_view_t;
+
+/**
+ * Callback of view mode, called for every sentence with right checksum
+ * @param view a pointer of sentence view, valid only during the call
+ * @param user_data user data passed to nmea_parse_view()
+ */
+typedef void (*nmea_view_handler_t)(const nmea_sentence_view_t *view, void *user_data);
+
+/**
+ * Callback of UBX frames with right checksum
+ * @param msg_id message class and ID (class << 8 | ID), NMEA_UBX_xxx
+ * @param payload a pointer of frame payload, valid only during the call
+ * @param payload_sz payload size
+ * @param user_data user data registered with handler
+ * @see nmea_parser_set_ubx_handler
+ */
+typedef void (*nmea_ubx_handler_t)(int msg_id, const rt_uint8_t *payload, int payload_sz, void *user_data);
+
+/**
+ * Sink of RTCM3 frames with right CRC
+ * @param frame a pointer of whole frame (from preamble to CRC), valid only
+ * during the call; it points into buffer given to parser when frame is
+ * there as a whole, or into parser cache otherwise
+ * @param frame_sz frame size
+ * @param user_data user data registered with sink
+ * @see nmea_parser_set_rtcm_sink
+ */
+typedef void (*nmea_rtcm_sink_t)(const rt_uint8_t *frame, int frame_sz, void *user_data);
+
+/**
+ * Handler of sentences starting with prefix, proprietary ones ($PUBX,00,
+ * $PMTK001, $PQTMEPE) or of other types parser does not decode ($GNEPE)
+ */
+typedef struct _nmea_prop_entry
+{
+    rt_uint32_t key;        /**< First NMEA_PROP_KEY_SIZE characters of prefix */
+    char        prefix[NMEA_PROP_PREFIX_SIZE]; /**< Sentence start after '$' */
+    rt_uint8_t  prefix_len;
+    rt_uint8_t  next;       /**< Next entry of bucket (index + 1), 0 - end */
+    nmea_view_handler_t handler;
+    void       *user_data;
+} nmea_prop_entry_t;
+
+/**
+ * Registry of sentence handlers: hash of prefix start selects bucket,
+ * bucket chain is kept ordered by prefix length so that the first match
+ * is the longest one. Standard sentences never look into it.
+ * @see nmea_parser_register_sentence
+ */
+typedef struct _nmea_prop_table
+{
+    int         count;
+    rt_uint8_t  bucket[NMEA_PROP_HASH_SIZE]; /**< First entry of bucket (index + 1), 0 - empty */
+    nmea_prop_entry_t entry[NMEA_PROP_MAX_HANDLERS];
+} nmea_prop_table_t;
+
+/**
+ * State of sentence framing, kept between calls of nmea_parser_feed()
+ */
+typedef struct _nmea_framer
+{
+    int     state;      /**< Framing state */
+    int     len;        /**< Number of bytes of current sentence (from '$') */
+    int     crc;        /**< Running XOR of bytes between '$' and '*' */
+    int     crc_rx;     /**< Checksum received after '*' */
+    int     ptype;      /**< Packet type, known after address field (NMEA_PACK_TYPE) */
+    int     field_count; /**< Number of fields separators seen */
+    int     bin_len;    /**< Payload length of binary (UBX, RTCM3) frame */
+    int     indexed;    /**< Field offsets belong to sentence passed to sink, set only right after publish */
+    rt_uint16_t field_off[NMEA_MAX_FIELDS]; /**< Offsets of ',' separators from '$' */
+} nmea_framer_t;
+
+typedef struct _nmea_parser
+{
+    void *top_node;
+    void *end_node;
+    unsigned char *buffer;
+    int buff_size;
+    /* positions of cache are index plus mirror flag in one word, 0 .. 2 * buff_size - 1,
+     * so each side publishes its position by single store */
+    volatile rt_uint32_t write_pos; /**< Write position of cache, stored by feeding side only */
+    volatile rt_uint32_t read_pos;  /**< Read position of cache, stored by draining side only */
+    rt_uint32_t buff_overflow; /**< Number of bytes discarded because cache was full */
+    rt_uint32_t crc_error; /**< Number of sentences with wrong checksum */
+    nmea_framer_t framer;
+    nmea_pack_handler_t handler;
+    void *user_data;
+#ifdef NMEA_USING_PACK_POOL
+    struct rt_mempool pack_mp;
+    void *pack_pool;
+#endif
+    rt_uint32_t pack_overflow; /**< Number of packets dropped because queue was full */
+    int enable_mask; /**< Packet types to be parsed (NMEA_PACK_TYPE), all by default */
+    int filter_fast; /**< Disabled types are dropped at address field, without checksum */
+    rt_uint32_t filter_drop[NMEA_PACK_TYPE_COUNT]; /**< Number of sentences dropped, by bit of mask */
+    nmea_prop_table_t prop; /**< Handlers of proprietary sentences */
+    rt_uint32_t prop_count; /**< Number of sentences passed to proprietary handlers */
+#ifdef NMEA_USING_UBX
+    nmea_ubx_handler_t ubx_handler;
+    void *ubx_user_data;
+    rt_uint32_t ubx_count; /**< Number of UBX frames with right checksum */
+    rt_uint32_t ubx_crc_error; /**< Number of UBX frames with wrong checksum */
+#endif
+#ifdef NMEA_USING_RTCM
+    nmea_rtcm_sink_t rtcm_sink;
+    void *rtcm_user_data;
+    rt_uint32_t rtcm_count; /**< Number of RTCM3 frames with right CRC */
+    rt_uint32_t rtcm_direct; /**< Number of them passed straight from buffer of caller */
+    rt_uint32_t rtcm_crc_error; /**< Number of RTCM3 frames with wrong CRC */
+#endif
+} nmea_parser_t;
+
+/**
+ * NMEA packets type which parsed and generated by library,
+ * matched by sentence ID for any talker (GPGGA, GNGGA, BDGGA, ...)
+ */
+enum NMEA_PACK_TYPE
+{
+    GPNON = 0x0000,   /**< Unknown packet type. */
+    GPGGA = 0x0001,   /**< GGA - Essential fix data which provide 3D location and accuracy data. */
+    GPGSA = 0x0002,   /**< GSA - GPS receiver operating mode, SVs used for navigation, and DOP values. */
+    GPGSV = 0x0004,   /**< GSV - Number of SVs in view, PRN numbers, elevation, azimuth & SNR values. */
+    GPRMC = 0x0008,   /**< RMC - Recommended Minimum Specific GPS/TRANSIT Data. */
+    GPVTG = 0x0010,   /**< VTG - Actual track made good and speed over ground. */
+    GPGLL = 0x0020,   /**< GLL - Geographic position, latitude and longitude. */
+    GPZDA = 0x0040,   /**< ZDA - Time and date. */
+    GPGST = 0x0080,   /**< GST - Pseudorange error statistics, error ellipse. */
+    GPGNS = 0x0100,   /**< GNS - GNSS fix data, mode by system. */
+    GPGRS = 0x0200,   /**< GRS - Range residuals. */
+    GPDTM = 0x0400,   /**< DTM - Datum reference. */
+    GPHDT = 0x0800    /**< HDT - True heading. */
+};
+
+/**
+ * Talker ID of sentence (first two characters of address field)
+ * @see nmea_pack_talker
+ */
+enum NMEA_TALKER
+{
+    NMEA_TALKER_NON = 0, /**< Unknown talker */
+    NMEA_TALKER_GP,      /**< GPS */
+    NMEA_TALKER_GL,      /**< GLONASS */
+    NMEA_TALKER_GA,      /**< Galileo */
+    NMEA_TALKER_GB,      /**< BeiDou */
+    NMEA_TALKER_BD,      /**< BeiDou (old talker ID) */
+    NMEA_TALKER_GQ,      /**< QZSS */
+    NMEA_TALKER_GN       /**< Combined GNSS solution */
+};
+
+/**
+ * GGA packet information structure (Global Positioning System Fix Data)
+ */
+typedef struct _nmea_gga
+{
+    int     talker;     /**< Talker ID (NMEA_TALKER) */
+    nmea_time_t utc;       /**< UTC of position (just time) */
+    nmea_coord_t lat;   /**< Latitude (nmea_coord_t) - [degree][min].[sec/60] */
+    char    ns;         /**< [N]orth or [S]outh */
+    nmea_coord_t lon;   /**< Longitude (nmea_coord_t) - [degree][min].[sec/60] */
+    char    ew;         /**< [E]ast or [W]est */
+    int     sig;        /**< GPS quality indicator (0 = Invalid; 1 = Fix; 2 = Differential, 3 = Sensitive) */
+    int     satinuse;   /**< Number of satellites in use (not those in view) */
+    nmea_centi_t HDOP;  /**< Horizontal dilution of precision */
+    nmea_dist_t elv;    /**< Antenna altitude above/below mean sea level (geoid) */
+    char    elv_units;  /**< [M]eters (Antenna height unit) */
+    nmea_dist_t diff;   /**< Geoidal separation (Diff. between WGS-84 earth ellipsoid and mean sea level. '-' = geoid is below WGS-84 ellipsoid) */
+    char    diff_units; /**< [M]eters (Units of geoidal separation) */
+    nmea_centi_t dgps_age; /**< Time in seconds since last DGPS update */
+    int     dgps_sid;   /**< DGPS station ID number */
+} nmea_gga_t;
+
+/**
+ * GSA packet information structure (Satellite status)
+ */
+typedef struct _nmea_gsa
+{
+    int     talker;     /**< Talker ID (NMEA_TALKER) */
+    char    fix_mode;   /**< Mode (M = Manual, forced to operate in 2D or 3D; A = Automatic, 3D/2D) */
+    int     fix_type;   /**< Type, used for navigation (1 = Fix not available; 2 = 2D; 3 = 3D) */
+    int     sat_prn[NMEA_MAXSAT]; /**< PRNs of satellites used in position fix (null for unused fields) */
+    nmea_centi_t PDOP;  /**< Dilution of precision */
+    nmea_centi_t HDOP;  /**< Horizontal dilution of precision */
+    nmea_centi_t VDOP;  /**< Vertical dilution of precision */
+    int     system_id;  /**< GNSS system ID (NMEA_SYSTEM), 0 - not reported (before NMEA 4.10) */
+} nmea_gsa_t;
+
+/**
+ * GSV packet information structure (Satellites in view)
+ */
+typedef struct _nmea_gsv
+{
+    int     talker;     /**< Talker ID (NMEA_TALKER) */
+    int     pack_count; /**< Total number of messages of this type in this cycle */
+    int     pack_index; /**< Message number */
+    int     sat_count;  /**< Total number of satellites in view */
+    nmea_satellite_t sat_data[NMEA_SATINPACK];
+    int     signal_id;  /**< Signal ID, 0 - not reported (before NMEA 4.10) */
+} nmea_gsv_t;
+
+/**
+ * RMC packet information structure (Recommended Minimum sentence C)
+ */
+typedef struct _nmea_rmc
+{
+    int     talker;     /**< Talker ID (NMEA_TALKER) */
+    nmea_time_t utc;       /**< UTC of position */
+    char    status;     /**< Status (A = active or V = void) */
+    nmea_coord_t lat;   /**< Latitude (nmea_coord_t) - [degree][min].[sec/60] */
+    char    ns;         /**< [N]orth or [S]outh */
+    nmea_coord_t lon;   /**< Longitude (nmea_coord_t) - [degree][min].[sec/60] */
+    char    ew;         /**< [E]ast or [W]est */
+    nmea_centi_t speed; /**< Speed over the ground in knots */
+    nmea_centi_t direction; /**< Track angle in degrees True */
+    nmea_centi_t declination; /**< Magnetic variation degrees (Easterly var. subtracts from true course) */
+    char    declin_ew;  /**< [E]ast or [W]est */
+    char    mode;       /**< Mode indicator of fix type (A = autonomous, D = differential, E = estimated, N = not valid, S = simulator) */
+} nmea_rmc_t;
+
+/**
+ * VTG packet information structure (Track made good and ground speed)
+ */
+typedef struct _nmea_vtg
+{
+    int     talker;     /**< Talker ID (NMEA_TALKER) */
+    nmea_centi_t dir;   /**< True track made good (degrees) */
+    char    dir_t;      /**< Fixed text 'T' indicates that track made good is relative to true north */
+    nmea_centi_t dec;   /**< Magnetic track made good */
+    char    dec_m;      /**< Fixed text 'M' */
+    nmea_centi_t spn;   /**< Ground speed, knots */
+    char    spn_n;      /**< Fixed text 'N' indicates that speed over ground is in knots */
+    nmea_centi_t spk;   /**< Ground speed, kilometers per hour */
+    char    spk_k;      /**< Fixed text 'K' indicates that speed over ground is in kilometers/hour */
+} nmea_vtg_t;
+
+/**
+ * GLL packet information structure (Geographic position, latitude and longitude)
+ */
+typedef struct _nmea_gll
+{
+    int     talker;     /**< Talker ID (NMEA_TALKER) */
+    nmea_coord_t lat;   /**< Latitude (nmea_coord_t) - [degree][min].[sec/60] */
+    char    ns;         /**< [N]orth or [S]outh */
+    nmea_coord_t lon;   /**< Longitude (nmea_coord_t) - [degree][min].[sec/60] */
+    char    ew;         /**< [E]ast or [W]est */
+    nmea_time_t utc;    /**< UTC of position (just time) */
+    char    status;     /**< Status (A = valid or V = not valid) */
+    char    mode;       /**< Mode indicator (A = autonomous, D = differential, E = estimated, N = not valid), 0 before NMEA 2.3 */
+} nmea_gll_t;
+
+/**
+ * ZDA packet information structure (Time and date)
+ */
+typedef struct _nmea_zda
+{
+    int     talker;     /**< Talker ID (NMEA_TALKER) */
+    nmea_time_t utc;    /**< UTC time and date */
+    int     zone_hour;  /**< Local zone hours, -13..13 */
+    int     zone_min;   /**< Local zone minutes, 0..59, sign is the sign of hours */
+} nmea_zda_t;
+
+/**
+ * GST packet information structure (Pseudorange error statistics)
+ */
+typedef struct _nmea_gst
+{
+    int     talker;     /**< Talker ID (NMEA_TALKER) */
+    nmea_time_t utc;    /**< UTC of position (just time) */
+    nmea_dist_t rms;    /**< RMS of standard deviation of range inputs, meters */
+    nmea_dist_t err_major; /**< Standard deviation of semi-major axis of error ellipse, meters */
+    nmea_dist_t err_minor; /**< Standard deviation of semi-minor axis of error ellipse, meters */
+    nmea_centi_t err_orient; /**< Orientation of semi-major axis, degrees from true north */
+    nmea_dist_t lat_err; /**< Standard deviation of latitude error, meters */
+    nmea_dist_t lon_err; /**< Standard deviation of longitude error, meters */
+    nmea_dist_t elv_err; /**< Standard deviation of altitude error, meters */
+} nmea_gst_t;
+
+/**
+ * GNS packet information structure (GNSS fix data)
+ */
+typedef struct _nmea_gns
+{
+    int     talker;     /**< Talker ID (NMEA_TALKER) */
+    nmea_time_t utc;    /**< UTC of position (just time) */
+    nmea_coord_t lat;   /**< Latitude (nmea_coord_t) - [degree][min].[sec/60] */
+    char    ns;         /**< [N]orth or [S]outh */
+    nmea_coord_t lon;   /**< Longitude (nmea_coord_t) - [degree][min].[sec/60] */
+    char    ew;         /**< [E]ast or [W]est */
+    char    mode[NMEA_FIELD_STR_SIZE]; /**< Mode indicator by system: GPS, GLONASS, Galileo, BeiDou, QZSS, NavIC (N, A, D, P, R, F, E, M, S) */
+    int     satinuse;   /**< Number of satellites in use */
+    nmea_centi_t HDOP;  /**< Horizontal dilution of precision */
+    nmea_dist_t elv;    /**< Antenna altitude above/below mean sea level (geoid), meters */
+    nmea_dist_t diff;   /**< Geoidal separation, meters */
+    nmea_centi_t dgps_age; /**< Time in seconds since last DGPS update */
+    int     dgps_sid;   /**< DGPS station ID number */
+    char    nav_status; /**< Navigational status (S = safe, C = caution, U = unsafe, V = not valid), 0 before NMEA 4.10 */
+} nmea_gns_t;
+
+/**
+ * GRS packet information structure (GNSS range residuals)
+ */
+typedef struct _nmea_grs
+{
+    int     talker;     /**< Talker ID (NMEA_TALKER) */
+    nmea_time_t utc;    /**< UTC of GGA position (just time) */
+    int     mode;       /**< 0 - residuals were used to calculate position of GGA, 1 - recomputed after it */
+    nmea_dist_t residual[NMEA_MAXSAT]; /**< Range residuals in meters, in order of satellites of GSA */
+    int     system_id;  /**< GNSS system ID (NMEA_SYSTEM), 0 - not reported (before NMEA 4.10) */
+    int     signal_id;  /**< Signal ID, 0 - not reported (before NMEA 4.10) */
+} nmea_grs_t;
+
+/**
+ * DTM packet information structure (Datum reference)
+ */
+typedef struct _nmea_dtm
+{
+    int     talker;     /**< Talker ID (NMEA_TALKER) */
+    char    datum[NMEA_FIELD_STR_SIZE]; /**< Local datum code (W84, W72, S85, P90, 999 - user defined) */
+    char    sub_datum[NMEA_FIELD_STR_SIZE]; /**< Local datum subdivision code */
+    nmea_dist_t lat_ofs; /**< Latitude offset, minutes */
+    char    ns;         /**< [N]orth or [S]outh */
+    nmea_dist_t lon_ofs; /**< Longitude offset, minutes */
+    char    ew;         /**< [E]ast or [W]est */
+    nmea_dist_t elv_ofs; /**< Altitude offset, meters */
+    char    ref_datum[NMEA_FIELD_STR_SIZE]; /**< Reference datum code, W84 */
+} nmea_dtm_t;
+
+/**
+ * HDT packet information structure (True heading)
+ */
+typedef struct _nmea_hdt
+{
+    int     talker;     /**< Talker ID (NMEA_TALKER) */
+    nmea_centi_t heading; /**< Heading, degrees True */
+    char    heading_t;  /**< Fixed text 'T' indicates that heading is relative to true north */
+} nmea_hdt_t;
+
+/**
+ * \brief Convert latitude or longitude of packet or nmea_info_t to degrees
+ */
+rt_inline double nmea_coord2degree(nmea_coord_t val)
+{
+#ifdef NMEA_USING_FIXED_POINT
+    return (double)val / NMEA_COORD_SCALE;
+#else
+    int deg = (int)(val / 100);
+
+    return deg + (val - deg * 100) / 60;
+#endif
+}
+
+/**
+ * \brief Convert altitude or distance of packet or nmea_info_t to meters
+ */
+rt_inline double nmea_dist2meter(nmea_dist_t val)
+{
+#ifdef NMEA_USING_FIXED_POINT
+    return (double)val / NMEA_DIST_SCALE;
+#else
+    return val;
+#endif
+}
+
+/**
+ * \brief Convert DOP, speed, angle or time of packet or nmea_info_t to double
+ */
+rt_inline double nmea_centi2double(nmea_centi_t val)
+{
+#ifdef NMEA_USING_FIXED_POINT
+    return (double)val / NMEA_CENTI_SCALE;
+#else
+    return val;
+#endif
+}
+
+/**
+ * Storage of any packet type, used to parse without heap allocation
+ */
+typedef union _nmea_pack
+{
+    nmea_gga_t gga;
+    nmea_gsa_t gsa;
+    nmea_gsv_t gsv;
+    nmea_rmc_t rmc;
+    nmea_vtg_t vtg;
+    nmea_gll_t gll;
+    nmea_zda_t zda;
+    nmea_gst_t gst;
+    nmea_gns_t gns;
+    nmea_grs_t grs;
+    nmea_dtm_t dtm;
+    nmea_hdt_t hdt;
+} nmea_pack_t;
+
+/**
+ * Callback of epoch assembler, called once per navigation cycle
+ * @param fix a pointer of consolidated fix, valid only during the call
+ * @param user_data user data registered with handler
+ * @see nmea_epoch_init
+ */
+typedef void (*nmea_epoch_handler_t)(const nmea_info_t *fix, void *user_data);
+
+/**
+ * Epoch assembler, groups packets of one navigation cycle into one fix.
+ * Cycle ends when UTC time of fix sentence (GGA, RMC, GNS, GLL) changes, or after packet of
+ * configured type (GSV - after the last message of GSV cycle).
+ * @see nmea_epoch_pack_handler
+ */
+typedef struct _nmea_epoch
+{
+    nmea_info_t fix;        /**< Fix of current cycle, smask is cleared on every cycle */
+    int         utc_key;    /**< UTC of current cycle in hundredths of second, -1 - not known yet */
+    int         last_type;  /**< Packet type which ends cycle (NMEA_PACK_TYPE), GPNON - by time change only */
+    rt_uint32_t count;      /**< Number of published fixes */
+    nmea_epoch_handler_t handler;
+    void       *user_data;
+} nmea_epoch_t;
+
+/**
+ * Satellites in view of one talker and signal, complete GSV cycle
+ * @see nmea_gsv_asm_t
+ */
+typedef struct _nmea_gsv_view
+{
+    int     talker;     /**< Talker ID (NMEA_TALKER) */
+    int     signal_id;  /**< Signal ID, 0 - not reported (before NMEA 4.10) */
+    int     sat_count;  /**< Total number of satellites in view */
+    int     sat_num;    /**< Number of satellites in sat[], less than sat_count if they do not fit */
+    nmea_satellite_t sat[NMEA_GSV_MAX_SAT];
+} nmea_gsv_view_t;
+
+/**
+ * Callback of GSV assembler, called when view is complete and changed
+ * @param view a pointer of view, valid only during the call
+ * @param user_data user data registered with handler
+ * @see nmea_gsv_asm_init
+ */
+typedef void (*nmea_gsv_handler_t)(const nmea_gsv_view_t *view, void *user_data);
+
+/**
+ * GSV cycle in progress of one talker and signal
+ */
+typedef struct _nmea_gsv_stream
+{
+    rt_uint32_t recv_mask;  /**< Received messages, bit 0 - message 1, 0 - no cycle in progress */
+    rt_uint32_t hash;       /**< Hash of last published view */
+    int         pack_count; /**< Number of messages of current cycle */
+    int         published;  /**< Non zero if view was published once */
+    nmea_gsv_view_t view;
+} nmea_gsv_stream_t;
+
+/**
+ * GSV assembler, collects messages of GSV cycle by talker and signal and
+ * publishes satellites in view only when all messages 1..pack_count were
+ * received and the view differs from the previous one.
+ * @see nmea_gsv_asm_pack_handler
+ */
+typedef struct _nmea_gsv_asm
+{
+    int         nstream;    /**< Number of used streams */
+    rt_uint32_t complete;   /**< Number of complete cycles */
+    rt_uint32_t published;  /**< Number of published views */
+    rt_uint32_t incomplete; /**< Number of cycles with lost messages */
+    rt_uint32_t overflow;   /**< Number of messages dropped, no free stream */
+    nmea_gsv_handler_t handler;
+    void       *user_data;
+    nmea_gsv_stream_t stream[NMEA_GSV_MAX_STREAMS];
+} nmea_gsv_asm_t;
+
+/**
+ * Batch parse of large buffer in place, one record by navigation cycle
+ * is written into arrays given by caller. Set array to RT_NULL to skip it.
+ * @see nmea_parse_batch
+ */
+typedef struct _nmea_batch
+{
+    int         capacity;   /**< Size of every output array, at least 2 */
+    int         count;      /**< Number of records written */
+    rt_uint32_t *offset;    /**< Byte offset of the first sentence of record in input */
+    rt_int32_t  *utc_ms;    /**< UTC time of day in milliseconds */
+    rt_int32_t  *date;      /**< UTC date as yyyymmdd, 0 - no RMC or ZDA in record */
+    nmea_coord_t *lat;      /**< Latitude (nmea_coord_t) */
+    nmea_coord_t *lon;      /**< Longitude (nmea_coord_t) */
+    nmea_dist_t *alt;       /**< Altitude above mean sea level */
+    nmea_centi_t *speed;    /**< Speed over the ground in kilometers/hour */
+    nmea_centi_t *course;   /**< Track angle in degrees True */
+    nmea_centi_t *hdop;     /**< Horizontal dilution of precision */
+    rt_uint8_t  *sig;       /**< GPS quality indicator (NMEA_SIG_xxx) */
+    rt_uint8_t  *fix;       /**< Operating mode (NMEA_FIX_xxx) */
+
+    int         err_capacity; /**< Size of err_offset array */
+    int         err_count;  /**< Number of broken sentences, may be more than err_capacity */
+    rt_uint32_t *err_offset; /**< Byte offsets of broken sentences in input */
+
+    rt_uint32_t base;       /**< Offset of current buffer in input */
+    rt_uint32_t rec_offset; /**< Offset of the first sentence of current cycle */
+    rt_uint32_t sen_offset; /**< Offset of sentence being added to cycle */
+    nmea_epoch_t epoch;     /**< Assembler of current cycle */
+} nmea_batch_t;
+
+/**
+ * Publication of the latest fix for any number of readers, without lock.
+ * Single writer fills the spare copy and then flips the sequence, reader
+ * copies the current one and retries if sequence was changed meanwhile.
+ * Writer never waits, so it may be ISR or UART receive thread.
+ * @see nmea_fix_publish, nmea_fix_read
+ */
+typedef struct _nmea_fix_pub
+{
+    volatile rt_uint32_t seq; /**< Number of published fixes, fix[seq & 1] is current */
+    nmea_info_t fix[2];     /**< Current and spare copy of fix */
+} nmea_fix_pub_t;
+
+int nmea_scanf(const char *buff, int buff_sz, const char *format, ...);
+int nmea_atoi(const char *str, int str_sz, int radix);
+int nmea_atoi_checked(const char *str, int str_sz, int radix, int *res);
+double nmea_atof(const char *str, int str_sz);
+int nmea_atofix(const char *str, int str_sz, int scale, rt_int32_t *res);
+double nmea_ndeg_atof(const char *str, int str_sz);
+int nmea_ndeg_atofix(const char *str, int str_sz, rt_int32_t *res);
+
+int     nmea_parser_init(nmea_parser_t *parser);
+void    nmea_parser_destroy(nmea_parser_t *parser);
+
+int     nmea_parse(
+    nmea_parser_t *parser,
+    const char *buff, int buff_sz,
+    nmea_info_t *info
+);
+
+void    nmea_parser_set_handler(
+    nmea_parser_t *parser,
+    nmea_pack_handler_t handler,
+    void *user_data
+);
+int     nmea_parse_stream(
+    nmea_parser_t *parser,
+    const char *buff, int buff_sz,
+    nmea_info_t *info
+);
+
+int     nmea_parse_view(
+    nmea_parser_t *parser,
+    const char *buff, int buff_sz,
+    nmea_view_handler_t handler, void *user_data
+);
+
+void    nmea_parser_set_filter(nmea_parser_t *parser, int enable_mask, int fast);
+int     nmea_parser_register_sentence(
+    nmea_parser_t *parser, const char *prefix,
+    nmea_view_handler_t handler, void *user_data
+);
+const nmea_prop_entry_t *nmea_prop_find(const nmea_prop_table_t *tab, const char *buff, int buff_sz);
+
+int     nmea_parser_feed(nmea_parser_t *parser, const char *buff, int buff_sz);
+int     nmea_parser_poll(nmea_parser_t *parser, nmea_info_t *info);
+
+int nmea_pack_type(const char *buff, int buff_sz);
+int nmea_pack_talker(const char *buff, int buff_sz);
+
+void nmea_sat_table_init(nmea_sat_table_t *tab);
+int nmea_sat_system(int talker, int system_id, int prn);
+nmea_sat_entry_t *nmea_sat_table_find(nmea_sat_table_t *tab, int system, int prn, int signal);
+nmea_sat_entry_t *nmea_sat_table_update(nmea_sat_table_t *tab, int system, int prn, int signal);
+void nmea_sat_table_gsv(nmea_sat_table_t *tab, nmea_gsv_t *pack);
+int nmea_sat_table_gsa(nmea_sat_table_t *tab, nmea_gsa_t *pack);
+int nmea_sat_in_use(const nmea_sat_table_t *tab, const nmea_sat_entry_t *sat);
+int nmea_sat_in_view(const nmea_sat_table_t *tab, const nmea_sat_entry_t *sat);
+int nmea_sat_table_inview(const nmea_sat_table_t *tab);
+int nmea_sat_table_inuse(const nmea_sat_table_t *tab);
+
+void nmea_epoch_init(nmea_epoch_t *epoch, int last_type, nmea_epoch_handler_t handler, void *user_data);
+int nmea_epoch_input(nmea_epoch_t *epoch, int ptype, void *pack);
+int nmea_epoch_flush(nmea_epoch_t *epoch);
+int nmea_epoch_utc(int ptype, void *pack);
+void nmea_epoch_pack_handler(int ptype, void *pack, void *user_data);
+
+void nmea_gsv_asm_init(nmea_gsv_asm_t *gsv_asm, nmea_gsv_handler_t handler, void *user_data);
+int nmea_gsv_asm_input(nmea_gsv_asm_t *gsv_asm, const nmea_gsv_t *pack);
+void nmea_gsv_asm_pack_handler(int ptype, void *pack, void *user_data);
+
+void nmea_fix_pub_init(nmea_fix_pub_t *pub);
+void nmea_fix_publish(nmea_fix_pub_t *pub, const nmea_info_t *fix);
+int nmea_fix_read(const nmea_fix_pub_t *pub, nmea_info_t *fix, rt_uint32_t *seq);
+void nmea_fix_pub_handler(const nmea_info_t *fix, void *user_data);
+
+void nmea_batch_init(nmea_batch_t *batch, int capacity, int last_type);
+void nmea_batch_reset(nmea_batch_t *batch);
+int nmea_parse_batch(nmea_batch_t *batch, const char *buff, int buff_sz);
+int nmea_batch_flush(nmea_batch_t *batch);
+int nmea_parse_parallel(nmea_batch_t *batch, const char *buff, int buff_sz, int nthreads);
+
+int nmea_view_init(nmea_sentence_view_t *view, const char *buff, int buff_sz);
+int nmea_view_index(nmea_sentence_view_t *view, const char *buff, int buff_sz,
+    const rt_uint16_t *field_off, int field_count);
+const char *nmea_view_field(const nmea_sentence_view_t *view, int idx, int *len);
+int nmea_view_get_int(const nmea_sentence_view_t *view, int idx);
+double nmea_view_get_double(const nmea_sentence_view_t *view, int idx);
+char nmea_view_get_char(const nmea_sentence_view_t *view, int idx);
+nmea_coord_t nmea_view_get_latlon(const nmea_sentence_view_t *view, int idx);
+int nmea_view_get_time(const nmea_sentence_view_t *view, int idx, nmea_time_t *res);
+int nmea_field_time(const char *str, int str_sz, nmea_time_t *res);
+
+rt_int64_t nmea_time_unix_ms(const nmea_time_t *utc);
+int nmea_time_leap_seconds(rt_int64_t unix_ms);
+rt_int64_t nmea_time_gps_ms(const nmea_time_t *utc, int leap_sec);
+int nmea_time_gps_week(const nmea_time_t *utc, int leap_sec, rt_int32_t *tow_ms);
+
+int nmea_find_tail(const char *buff, int buff_sz, int *res_crc);
+int nmea_find_tail_ref(const char *buff, int buff_sz, int *res_crc);
+int nmea_scan_sentence(const char *buff, int buff_sz, int *res_crc);
+int nmea_pack_decode(int ptype, const char *buff, int buff_sz, nmea_pack_t *pack);
+#ifndef NMEA_USING_FIXED_POINT
+int nmea_pack_scanf(int ptype, const char *buff, int buff_sz, nmea_pack_t *pack);
+#endif
+void nmea_pack_info(int ptype, void *pack, nmea_info_t *info);
+
+int nmea_parse_gga(const char *buff, int buff_sz, nmea_gga_t *pack);
+int nmea_parse_gsa(const char *buff, int buff_sz, nmea_gsa_t *pack);
+int nmea_parse_gsv(const char *buff, int buff_sz, nmea_gsv_t *pack);
+int nmea_parse_rmc(const char *buff, int buff_sz, nmea_rmc_t *pack);
+int nmea_parse_vtg(const char *buff, int buff_sz, nmea_vtg_t *pack);
+int nmea_parse_gll(const char *buff, int buff_sz, nmea_gll_t *pack);
+int nmea_parse_zda(const char *buff, int buff_sz, nmea_zda_t *pack);
+int nmea_parse_gst(const char *buff, int buff_sz, nmea_gst_t *pack);
+int nmea_parse_gns(const char *buff, int buff_sz, nmea_gns_t *pack);
+int nmea_parse_grs(const char *buff, int buff_sz, nmea_grs_t *pack);
+int nmea_parse_dtm(const char *buff, int buff_sz, nmea_dtm_t *pack);
+int nmea_parse_hdt(const char *buff, int buff_sz, nmea_hdt_t *pack);
+
+int nmea_gen_gga(char *buff, int buff_sz, const nmea_gga_t *pack);
+int nmea_gen_gsa(char *buff, int buff_sz, const nmea_gsa_t *pack);
+int nmea_gen_gsv(char *buff, int buff_sz, const nmea_gsv_t *pack);
+int nmea_gen_rmc(char *buff, int buff_sz, const nmea_rmc_t *pack);
+int nmea_gen_vtg(char *buff, int buff_sz, const nmea_vtg_t *pack);
+void nmea_info2gga(const nmea_info_t *info, int talker, nmea_gga_t *pack);
+void nmea_info2gsa(const nmea_info_t *info, int talker, nmea_gsa_t *pack);
+void nmea_info2gsv(const nmea_info_t *info, int talker, int pack_idx, nmea_gsv_t *pack);
+void nmea_info2rmc(const nmea_info_t *info, int talker, nmea_rmc_t *pack);
+void nmea_info2vtg(const nmea_info_t *info, int talker, nmea_vtg_t *pack);
+int nmea_generate(char *buff, int buff_sz, const nmea_info_t *info, int talker, int generate_mask);
+
+/**
+ * NAV-PVT message of UBX protocol (Navigation position velocity time solution)
+ */
+typedef struct _nmea_ubx_pvt
+{
+    rt_uint32_t itow;   /**< GPS time of week of navigation epoch, ms */
+    rt_uint16_t year;   /**< UTC year */
+    rt_uint8_t  month;  /**< UTC month, 1..12 */
+    rt_uint8_t  day;    /**< UTC day of month, 1..31 */
+    rt_uint8_t  hour;
+    rt_uint8_t  min;
+    rt_uint8_t  sec;    /**< UTC seconds, 60 - leap second */
+    rt_uint8_t  valid;  /**< 0x01 - date is valid, 0x02 - time is valid, 0x04 - fully resolved */
+    rt_uint32_t t_acc;  /**< Time accuracy estimate, ns */
+    rt_int32_t  nano;   /**< Fraction of second, ns, -1e9..1e9 */
+    rt_uint8_t  fix_type; /**< 0 - no fix, 1 - dead reckoning, 2 - 2D, 3 - 3D, 4 - GNSS and dead reckoning, 5 - time only */
+    rt_uint8_t  flags;  /**< 0x01 - gnssFixOK, 0x02 - diffSoln, 0xC0 - carrSoln (1 - float, 2 - fixed) */
+    rt_uint8_t  num_sv; /**< Number of satellites used in solution */
+    rt_int32_t  lon;    /**< Longitude, 1e-7 degrees */
+    rt_int32_t  lat;    /**< Latitude, 1e-7 degrees */
+    rt_int32_t  height; /**< Height above ellipsoid, mm */
+    rt_int32_t  h_msl;  /**< Height above mean sea level, mm */
+    rt_uint32_t h_acc;  /**< Horizontal accuracy estimate, mm */
+    rt_uint32_t v_acc;  /**< Vertical accuracy estimate, mm */
+    rt_int32_t  vel_n;  /**< NED north velocity, mm/s */
+    rt_int32_t  vel_e;  /**< NED east velocity, mm/s */
+    rt_int32_t  vel_d;  /**< NED down velocity, mm/s */
+    rt_int32_t  g_speed; /**< Ground speed, mm/s */
+    rt_int32_t  head_mot; /**< Heading of motion, 1e-5 degrees */
+    rt_uint32_t s_acc;  /**< Speed accuracy estimate, mm/s */
+    rt_uint32_t head_acc; /**< Heading accuracy estimate, 1e-5 degrees */
+    rt_uint16_t p_dop;  /**< Position DOP, 0.01 */
+} nmea_ubx_pvt_t;
+
+/**
+ * Satellite of NAV-SAT message
+ */
+typedef struct _nmea_ubx_sv
+{
+    rt_uint8_t  gnss_id; /**< 0 - GPS, 1 - SBAS, 2 - Galileo, 3 - BeiDou, 5 - QZSS, 6 - GLONASS */
+    rt_uint8_t  sv_id;  /**< Satellite ID within system */
+    rt_uint8_t  cno;    /**< Carrier to noise ratio, dBHz */
+    rt_int8_t   elev;   /**< Elevation, degrees, -90..90 */
+    rt_int16_t  azim;   /**< Azimuth, degrees, 0..360 */
+    rt_int16_t  pr_res; /**< Pseudorange residual, 0.1 m */
+    rt_uint32_t flags;  /**< 0x07 - signal quality, 0x08 - used in navigation */
+} nmea_ubx_sv_t;
+
+/**
+ * Header of NAV-SAT message of UBX protocol (Satellite information),
+ * satellites are decoded one by one by nmea_ubx_decode_sv()
+ */
+typedef struct _nmea_ubx_sat
+{
+    rt_uint32_t itow;   /**< GPS time of week of navigation epoch, ms */
+    rt_uint8_t  version;
+    rt_uint8_t  num_svs; /**< Number of satellites of message */
+} nmea_ubx_sat_t;
+
+#ifdef NMEA_USING_UBX
+void nmea_parser_set_ubx_handler(nmea_parser_t *parser, nmea_ubx_handler_t handler, void *user_data);
+#endif
+rt_uint16_t nmea_ubx_checksum(const rt_uint8_t *buff, int buff_sz);
+int nmea_ubx_decode_pvt(const rt_uint8_t *payload, int payload_sz, nmea_ubx_pvt_t *pvt);
+int nmea_ubx_decode_sat(const rt_uint8_t *payload, int payload_sz, nmea_ubx_sat_t *sat);
+int nmea_ubx_decode_sv(const rt_uint8_t *payload, int payload_sz, int idx, nmea_ubx_sv_t *sv);
+void nmea_ubx_pvt_info(const nmea_ubx_pvt_t *pvt, nmea_info_t *info);
+void nmea_ubx_sat_info(const rt_uint8_t *payload, int payload_sz, nmea_info_t *info);
+void nmea_ubx_info_handler(int msg_id, const rt_uint8_t *payload, int payload_sz, void *user_data);
+
+#ifdef NMEA_USING_RTCM
+void nmea_parser_set_rtcm_sink(nmea_parser_t *parser, nmea_rtcm_sink_t sink, void *user_data);
+#endif
+rt_uint32_t nmea_crc24q(rt_uint32_t crc, const rt_uint8_t *buff, int buff_sz);
+int nmea_rtcm_frame(const rt_uint8_t *buff, int buff_sz);
+int nmea_rtcm_msg_type(const rt_uint8_t *frame);
+
+#ifdef  __cplusplus
+}
+#endif
+
+#endif
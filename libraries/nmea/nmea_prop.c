@@ -0,0 +1,111 @@
+#include <nmea_parse.h>
+
+/*
+ * Registry of proprietary sentence handlers. Buckets are selected by hash
+ * of the first NMEA_PROP_KEY_SIZE characters after '$', so lookup costs the
+ * same for any number of handlers; chains are sorted at registration, the
+ * sentence is compared only with prefixes of its own bucket.
+ */
+
+#define NMEA_PROP_HASH_MUL      (2654435761u) /**< Knuth multiplicative hash */
+
+/**
+ * \brief Pack first characters of sentence (after '$') into key.
+ */
+rt_inline rt_uint32_t nmea_prop_key(const char *str)
+{
+    return ((rt_uint32_t)(rt_uint8_t)str[0] << 24) | ((rt_uint32_t)(rt_uint8_t)str[1] << 16) |
+        ((rt_uint32_t)(rt_uint8_t)str[2] << 8) | (rt_uint8_t)str[3];
+}
+
+rt_inline int nmea_prop_bucket(rt_uint32_t key)
+{
+    return (int)((key * NMEA_PROP_HASH_MUL) >> (32 - NMEA_PROP_HASH_BITS));
+}
+
+/**
+ * \brief Find handler of sentence, the one with the longest matching prefix.
+ * @param tab a pointer of registry.
+ * @param buff a constant character pointer of sentence (after '$').
+ * @param buff_sz sentence size.
+ * @return Pointer of entry or RT_NULL if no prefix matches
+ */
+const nmea_prop_entry_t *nmea_prop_find(const nmea_prop_table_t *tab, const char *buff, int buff_sz)
+{
+    const nmea_prop_entry_t *entry;
+    rt_uint32_t key;
+    int idx;
+
+    NMEA_ASSERT(tab && buff);
+
+    if (buff_sz < NMEA_PROP_KEY_SIZE)
+        return RT_NULL;
+
+    key = nmea_prop_key(buff);
+    for (idx = tab->bucket[nmea_prop_bucket(key)]; idx; idx = entry->next)
+    {
+        entry = &tab->entry[idx - 1];
+        if (entry->key == key && entry->prefix_len <= buff_sz &&
+            0 == rt_memcmp(entry->prefix + NMEA_PROP_KEY_SIZE, buff + NMEA_PROP_KEY_SIZE,
+                entry->prefix_len - NMEA_PROP_KEY_SIZE))
+            return entry;
+    }
+
+    return RT_NULL;
+}
+
+/**
+ * \brief Register handler of sentences starting with prefix. Such sentences
+ * with right checksum are passed to handler as view with fields already
+ * split by framing, in every parse mode. Handler of prefix registered before
+ * is replaced.
+ * @param prefix sentence start after '$', at least NMEA_PROP_KEY_SIZE characters
+ * ("PUBX,00", "PMTK", "PQTMEPE", "GNEPE").
+ * @param handler callback of sentence.
+ * @param user_data user data passed to handler.
+ * @return 0 - success or -1 - prefix is too short or long, or registry is full
+ */
+int nmea_parser_register_sentence(
+    nmea_parser_t *parser, const char *prefix,
+    nmea_view_handler_t handler, void *user_data
+)
+{
+    nmea_prop_table_t *tab;
+    nmea_prop_entry_t *entry;
+    rt_uint8_t *link;
+    int len, bucket;
+
+    NMEA_ASSERT(parser && prefix && handler);
+
+    tab = &parser->prop;
+    len = (int)rt_strlen(prefix);
+    if (len < NMEA_PROP_KEY_SIZE || len >= NMEA_PROP_PREFIX_SIZE)
+        return -1;
+
+    entry = (nmea_prop_entry_t *)nmea_prop_find(tab, prefix, len);
+    if (entry && entry->prefix_len == len)
+    {
+        entry->handler = handler;
+        entry->user_data = user_data;
+        return 0;
+    }
+
+    if (tab->count >= NMEA_PROP_MAX_HANDLERS)
+        return -1;
+
+    entry = &tab->entry[tab->count++];
+    entry->key = nmea_prop_key(prefix);
+    rt_memcpy(entry->prefix, prefix, len + 1);
+    entry->prefix_len = (rt_uint8_t)len;
+    entry->handler = handler;
+    entry->user_data = user_data;
+
+    /* longer prefixes first, so the first match is the most specific one */
+    bucket = nmea_prop_bucket(entry->key);
+    for (link = &tab->bucket[bucket]; *link && tab->entry[*link - 1].prefix_len >= len; link = &tab->entry[*link - 1].next)
+        ;
+    entry->next = *link;
+    *link = (rt_uint8_t)tab->count;
+
+    return 0;
+}
@@ -0,0 +1,391 @@
+#include <nmea_parse.h>
+
+/*
+ * Satellites table of all systems: open addressing with linear probing,
+ * one probe per GSV satellite in usual case. Satellites which were not
+ * reported by GSV for two cycles are dropped when table fills up.
+ */
+
+#if (NMEA_SAT_TABLE_SIZE & (NMEA_SAT_TABLE_SIZE - 1))
+#error "NMEA_SAT_TABLE_SIZE must be power of two"
+#endif
+
+#define NMEA_SAT_MASK           (NMEA_SAT_TABLE_SIZE - 1)
+#define NMEA_SAT_MAX_LOAD       (NMEA_SAT_TABLE_SIZE * 3 / 4) /**< Purge table at this number of entries */
+#define NMEA_SAT_GEN_FIRST      (2)  /**< Generation after wrap, 0 and 1 are kept for rebased entries */
+
+rt_inline rt_uint32_t nmea_sat_hash(int system, int prn, int signal)
+{
+    rt_uint32_t key = ((rt_uint32_t)system << 20) | ((rt_uint32_t)signal << 16) | (rt_uint32_t)prn;
+
+    return ((key * 2654435761u) >> 16) & NMEA_SAT_MASK;
+}
+
+/**
+ * \brief Initialize satellites table.
+ * @param tab a pointer of table.
+ */
+void nmea_sat_table_init(nmea_sat_table_t *tab)
+{
+    NMEA_ASSERT(tab);
+
+    rt_memset(tab, 0, sizeof(nmea_sat_table_t));
+}
+
+/**
+ * \brief Define GNSS system of satellite.
+ * @param talker talker ID of sentence (NMEA_TALKER).
+ * @param system_id system ID from sentence, 0 - not reported.
+ * @param prn satellite PRN number, used for combined (GN) talker before NMEA 4.10.
+ * @return The GNSS system (NMEA_SYSTEM)
+ */
+int nmea_sat_system(int talker, int system_id, int prn)
+{
+    if (system_id > NMEA_SYSTEM_NON && system_id < NMEA_SYSTEM_MAX)
+        return system_id;
+
+    switch (talker)
+    {
+    case NMEA_TALKER_GP:
+        return NMEA_SYSTEM_GPS;
+    case NMEA_TALKER_GL:
+        return NMEA_SYSTEM_GLONASS;
+    case NMEA_TALKER_GA:
+        return NMEA_SYSTEM_GALILEO;
+    case NMEA_TALKER_GB:
+    case NMEA_TALKER_BD:
+        return NMEA_SYSTEM_BEIDOU;
+    case NMEA_TALKER_GQ:
+        return NMEA_SYSTEM_QZSS;
+    };
+
+    /* PRN ranges used by combined talker of NMEA 4.00 receivers */
+    if (prn >= 65 && prn <= 96)
+        return NMEA_SYSTEM_GLONASS;
+    if (prn >= 193 && prn <= 200)
+        return NMEA_SYSTEM_QZSS;
+    if (prn >= 201 && prn <= 264)
+        return NMEA_SYSTEM_BEIDOU;
+    if (prn >= 301 && prn <= 336)
+        return NMEA_SYSTEM_GALILEO;
+    if (prn >= 401 && prn <= 437)
+        return NMEA_SYSTEM_BEIDOU;
+
+    return NMEA_SYSTEM_GPS;
+}
+
+/**
+ * \brief Find satellite in table.
+ * @return Pointer of entry or RT_NULL if not found
+ */
+nmea_sat_entry_t *nmea_sat_table_find(nmea_sat_table_t *tab, int system, int prn, int signal)
+{
+    rt_uint32_t pos = nmea_sat_hash(system, prn, signal);
+    nmea_sat_entry_t *sat;
+    int nprobe;
+
+    NMEA_ASSERT(tab);
+
+    for (nprobe = 0; nprobe < NMEA_SAT_TABLE_SIZE; ++nprobe, pos = (pos + 1) & NMEA_SAT_MASK)
+    {
+        sat = &tab->sat[pos];
+        if (!sat->prn)
+            break;
+        if (sat->prn == prn && sat->system == system && sat->signal == signal)
+            return sat;
+    }
+
+    return RT_NULL;
+}
+
+/**
+ * \brief Insert entry without check of duplicates, table must have free entry.
+ */
+static nmea_sat_entry_t *nmea_sat_table_insert(nmea_sat_table_t *tab, const nmea_sat_entry_t *src)
+{
+    rt_uint32_t pos = nmea_sat_hash(src->system, src->prn, src->signal);
+
+    while (tab->sat[pos].prn)
+        pos = (pos + 1) & NMEA_SAT_MASK;
+
+    tab->sat[pos] = *src;
+    tab->count++;
+
+    return &tab->sat[pos];
+}
+
+/**
+ * \brief Drop satellites out of view and rehash the rest in place.
+ */
+static void nmea_sat_table_purge(nmea_sat_table_t *tab)
+{
+    nmea_sat_entry_t entry;
+    int it, pos, start = 0;
+
+    for (it = 0; it < NMEA_SAT_TABLE_SIZE; ++it)
+    {
+        if (!tab->sat[it].prn)
+            start = it;
+        else if (!nmea_sat_in_view(tab, &tab->sat[it]))
+        {
+            tab->sat[it].prn = 0;
+            tab->count--;
+        }
+    }
+
+    /* no probe chain crosses entry which was free before purge, starting
+     * after it every chain is rebuilt from its beginning */
+    for (it = 1; it <= NMEA_SAT_TABLE_SIZE; ++it)
+    {
+        pos = (start + it) & NMEA_SAT_MASK;
+        if (!tab->sat[pos].prn)
+            continue;
+        entry = tab->sat[pos];
+        tab->sat[pos].prn = 0;
+        tab->count--;
+        nmea_sat_table_insert(tab, &entry);
+    }
+}
+
+/**
+ * \brief Find satellite in table or add new one.
+ * @return Pointer of entry or RT_NULL if table is full
+ */
+nmea_sat_entry_t *nmea_sat_table_update(nmea_sat_table_t *tab, int system, int prn, int signal)
+{
+    nmea_sat_entry_t *sat, entry;
+
+    NMEA_ASSERT(tab);
+
+    if (prn <= 0 || prn > 0xFFFF || system <= NMEA_SYSTEM_NON || system >= NMEA_SYSTEM_MAX ||
+        signal < 0 || signal >= NMEA_SAT_SIGNAL_COUNT)
+        return RT_NULL;
+
+    sat = nmea_sat_table_find(tab, system, prn, signal);
+    if (sat)
+        return sat;
+
+    if (tab->count >= NMEA_SAT_MAX_LOAD)
+    {
+        nmea_sat_table_purge(tab);
+        if (tab->count >= NMEA_SAT_MAX_LOAD)
+        {
+            tab->overflow++;
+            return RT_NULL;
+        }
+    }
+
+    rt_memset(&entry, 0, sizeof(entry));
+    entry.prn = (rt_uint16_t)prn;
+    entry.system = (rt_uint8_t)system;
+    entry.signal = (rt_uint8_t)signal;
+    tab->signals[system] |= 1 << signal;
+
+    return nmea_sat_table_insert(tab, &entry);
+}
+
+/**
+ * \brief Start new GSV cycle of signal. When counter wraps, satellites of
+ * the cycle before are rebased to generation 1, older ones to 0, so they
+ * are never taken as seen again.
+ */
+static void nmea_sat_table_seen_next(nmea_sat_table_t *tab, int system, int signal)
+{
+    rt_uint8_t prev = tab->seen_gen[system][signal];
+    nmea_sat_entry_t *sat;
+    int it;
+
+    tab->view_count[system][signal] = 0;
+    if (++tab->seen_gen[system][signal])
+        return;
+
+    for (it = 0; it < NMEA_SAT_TABLE_SIZE; ++it)
+    {
+        sat = &tab->sat[it];
+        if (sat->prn && sat->system == system && sat->signal == signal)
+            sat->seen_gen = (sat->seen_gen == prev) ? NMEA_SAT_GEN_FIRST - 1 : 0;
+    }
+    tab->seen_gen[system][signal] = NMEA_SAT_GEN_FIRST;
+}
+
+/**
+ * \brief Start new GSA of system. When counter wraps, marks of all
+ * satellites of system are cleared, 0 is never the current GSA.
+ */
+static void nmea_sat_table_used_next(nmea_sat_table_t *tab, int system)
+{
+    int it;
+
+    if (++tab->used_gen[system])
+        return;
+
+    for (it = 0; it < NMEA_SAT_TABLE_SIZE; ++it)
+    {
+        if (tab->sat[it].system == system)
+            tab->sat[it].used_gen = 0;
+    }
+    tab->used_gen[system] = 1;
+}
+
+/**
+ * \brief Update table by GSV packet data.
+ * @param tab a pointer of table.
+ * @param pack a pointer of packet structure.
+ */
+void nmea_sat_table_gsv(nmea_sat_table_t *tab, nmea_gsv_t *pack)
+{
+    nmea_sat_entry_t *sat;
+    int isat, system, signal = pack->signal_id;
+
+    NMEA_ASSERT(tab && pack);
+
+    if (signal < 0 || signal >= NMEA_SAT_SIGNAL_COUNT)
+        return;
+
+    /* message number which does not go up starts new cycle, even if the first one was lost */
+    if (1 == pack->pack_index || pack->pack_index <= tab->cycle_index)
+        tab->cycle_systems = 0;
+    tab->cycle_index = pack->pack_index;
+
+    for (isat = 0; isat < NMEA_SATINPACK; ++isat)
+    {
+        if (!pack->sat_data[isat].id)
+            continue;
+
+        system = nmea_sat_system(pack->talker, 0, pack->sat_data[isat].id);
+
+        /* combined talker mixes systems in one cycle, each system starts
+         * new generation of satellites in view of signal at its first satellite */
+        if (!(tab->cycle_systems & (1 << system)))
+        {
+            tab->cycle_systems |= 1 << system;
+            nmea_sat_table_seen_next(tab, system, signal);
+        }
+
+        sat = nmea_sat_table_update(tab, system, pack->sat_data[isat].id, signal);
+        if (!sat)
+            continue;
+
+        sat->elv = (rt_int8_t)pack->sat_data[isat].elv;
+        sat->azimuth = (rt_uint16_t)pack->sat_data[isat].azimuth;
+        sat->sig = (rt_uint8_t)pack->sat_data[isat].sig;
+        if (sat->seen_gen != tab->seen_gen[system][signal])
+            tab->view_count[system][signal]++;
+        sat->seen_gen = tab->seen_gen[system][signal];
+    }
+}
+
+/**
+ * \brief Mark satellites of GSA packet as used in position fix.
+ * Marks of previous GSA of the same system are dropped.
+ * @param tab a pointer of table.
+ * @param pack a pointer of packet structure.
+ * @return Number of satellites was marked
+ */
+int nmea_sat_table_gsa(nmea_sat_table_t *tab, nmea_gsa_t *pack)
+{
+    nmea_sat_entry_t *sat;
+    int i, signal, system = NMEA_SYSTEM_NON, nuse = 0;
+    rt_uint16_t signals;
+
+    NMEA_ASSERT(tab && pack);
+
+    for (i = 0; i < NMEA_MAXSAT; ++i)
+    {
+        if (!pack->sat_prn[i])
+            continue;
+
+        /* GSA has one system, defined by first satellite for NMEA 4.00 */
+        if (NMEA_SYSTEM_NON == system)
+        {
+            system = nmea_sat_system(pack->talker, pack->system_id, pack->sat_prn[i]);
+            nmea_sat_table_used_next(tab, system);
+            tab->used_count[system] = 0;
+        }
+
+        /* GSA has no signal ID, mark all signals of satellite */
+        signals = tab->signals[system];
+        for (signal = 0; signals; ++signal, signals >>= 1)
+        {
+            if (!(signals & 1))
+                continue;
+            sat = nmea_sat_table_find(tab, system, pack->sat_prn[i], signal);
+            if (sat)
+                sat->used_gen = tab->used_gen[system];
+        }
+        nuse++;
+    }
+
+    if (NMEA_SYSTEM_NON != system)
+    {
+        tab->used_count[system] = (rt_uint8_t)nuse;
+    }
+    else if (pack->system_id || NMEA_TALKER_GN != pack->talker)
+    {
+        /* empty GSA still drops marks, if its system is known */
+        system = nmea_sat_system(pack->talker, pack->system_id, 0);
+        nmea_sat_table_used_next(tab, system);
+        tab->used_count[system] = 0;
+    }
+
+    return nuse;
+}
+
+/**
+ * \brief Get number of satellites in view of all systems. Satellite of
+ * several signals is counted once: signal with most satellites is taken by system.
+ */
+int nmea_sat_table_inview(const nmea_sat_table_t *tab)
+{
+    int system, signal, nview, res = 0;
+
+    NMEA_ASSERT(tab);
+
+    for (system = NMEA_SYSTEM_GPS; system < NMEA_SYSTEM_MAX; ++system)
+    {
+        nview = 0;
+        for (signal = 0; signal < NMEA_SAT_SIGNAL_COUNT; ++signal)
+        {
+            if (tab->view_count[system][signal] > nview)
+                nview = tab->view_count[system][signal];
+        }
+        res += nview;
+    }
+
+    return res;
+}
+
+/**
+ * \brief Get number of satellites used in position fix by last GSA of every system.
+ */
+int nmea_sat_table_inuse(const nmea_sat_table_t *tab)
+{
+    int system, res = 0;
+
+    NMEA_ASSERT(tab);
+
+    for (system = NMEA_SYSTEM_GPS; system < NMEA_SYSTEM_MAX; ++system)
+        res += tab->used_count[system];
+
+    return res;
+}
+
+/**
+ * \brief Check that satellite is used in position fix by last GSA of its system.
+ */
+int nmea_sat_in_use(const nmea_sat_table_t *tab, const nmea_sat_entry_t *sat)
+{
+    NMEA_ASSERT(tab && sat);
+
+    return sat->used_gen && sat->used_gen == tab->used_gen[sat->system];
+}
+
+/**
+ * \brief Check that satellite was reported by current or previous GSV cycle of its signal.
+ */
+int nmea_sat_in_view(const nmea_sat_table_t *tab, const nmea_sat_entry_t *sat)
+{
+    NMEA_ASSERT(tab && sat);
+
+    return sat->seen_gen && (rt_uint8_t)(tab->seen_gen[sat->system][sat->signal] - sat->seen_gen) <= 1;
+}
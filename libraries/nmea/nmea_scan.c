@@ -0,0 +1,113 @@
+#include <nmea_parse.h>
+
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
+/*
+ * Search of sentence delimiters with checksum folded over whole words:
+ * 32 or 16 bytes by AVX2 or SSE2 on x86-64, 4 bytes by general registers
+ * on 32-bit targets (Cortex-M3 and later allow unaligned word loads).
+ */
+
+#define NMEA_SCAN_ONES          (0x01010101UL)
+#define NMEA_SCAN_HIGHS         (0x80808080UL)
+
+/** Non zero if any byte of word is zero, lowest flagged byte is exact */
+#define NMEA_SCAN_HASZERO(v)    (((v) - NMEA_SCAN_ONES) & ~(v) & NMEA_SCAN_HIGHS)
+
+/**
+ * \brief Load 32-bit word from any address.
+ */
+rt_inline rt_uint32_t nmea_scan_load(const char *ptr)
+{
+    rt_uint32_t word;
+
+    rt_memcpy(&word, ptr, sizeof(word));
+
+    return word;
+}
+
+/**
+ * \brief Find first '$' or '*' of sentence and XOR of bytes before it.
+ * @param buff a constant character pointer of buffer, starts at '$'.
+ * @param buff_sz buffer size.
+ * @param res_crc a pointer for return XOR of bytes from buff[1] to the delimiter,
+ * same as char by char sum would give.
+ * @return Index of '*' (may be 0), '$' (not 0) or buff_sz if no delimiter
+ */
+int nmea_scan_sentence(const char *buff, int buff_sz, int *res_crc)
+{
+    rt_uint32_t word, acc = 0;
+    rt_uint8_t crc;
+    int pos = 1;
+
+    NMEA_ASSERT(buff && res_crc);
+
+    if (buff_sz > 0 && '*' == buff[0])
+    {
+        *res_crc = 0;
+        return 0;
+    }
+
+#if defined(__AVX2__)
+    {
+        const __m256i dollar = _mm256_set1_epi8('$');
+        const __m256i star = _mm256_set1_epi8('*');
+        __m256i vacc = _mm256_setzero_si256(), v;
+        __m128i half;
+
+        for (; pos + 32 <= buff_sz; pos += 32)
+        {
+            v = _mm256_loadu_si256((const __m256i *)(buff + pos));
+            if (_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(v, dollar), _mm256_cmpeq_epi8(v, star))))
+                break;
+            vacc = _mm256_xor_si256(vacc, v);
+        }
+
+        half = _mm_xor_si128(_mm256_castsi256_si128(vacc), _mm256_extracti128_si256(vacc, 1));
+        half = _mm_xor_si128(half, _mm_srli_si128(half, 8));
+        half = _mm_xor_si128(half, _mm_srli_si128(half, 4));
+        acc = (rt_uint32_t)_mm_cvtsi128_si32(half);
+    }
+#elif defined(__SSE2__) || defined(_M_X64)
+    {
+        const __m128i dollar = _mm_set1_epi8('$');
+        const __m128i star = _mm_set1_epi8('*');
+        __m128i vacc = _mm_setzero_si128(), v;
+
+        for (; pos + 16 <= buff_sz; pos += 16)
+        {
+            v = _mm_loadu_si128((const __m128i *)(buff + pos));
+            if (_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(v, dollar), _mm_cmpeq_epi8(v, star))))
+                break;
+            vacc = _mm_xor_si128(vacc, v);
+        }
+
+        vacc = _mm_xor_si128(vacc, _mm_srli_si128(vacc, 8));
+        vacc = _mm_xor_si128(vacc, _mm_srli_si128(vacc, 4));
+        acc = (rt_uint32_t)_mm_cvtsi128_si32(vacc);
+    }
+#endif
+
+    for (; pos + 4 <= buff_sz; pos += 4)
+    {
+        word = nmea_scan_load(buff + pos);
+        if (NMEA_SCAN_HASZERO(word ^ ('$' * NMEA_SCAN_ONES)) | NMEA_SCAN_HASZERO(word ^ ('*' * NMEA_SCAN_ONES)))
+            break;
+        acc ^= word;
+    }
+
+    acc ^= acc >> 16;
+    acc ^= acc >> 8;
+    crc = (rt_uint8_t)acc;
+
+    /* delimiter is in the next word, or the rest is shorter than word */
+    for (; pos < buff_sz && '$' != buff[pos] && '*' != buff[pos]; ++pos)
+        crc ^= (rt_uint8_t)buff[pos];
+
+    /* bytes are summed as char, so keep the sign extension of char */
+    *res_crc = (int)(char)crc;
+
+    return pos;
+}
@@ -0,0 +1,129 @@
+#include <nmea_parse.h>
+
+/*
+ * UTC of packets to linear time by integer arithmetic only: no struct tm,
+ * no mktime() and no time zone, date and time fields go straight to
+ * milliseconds since 1970-01-01 or since GPS epoch 1980-01-06.
+ */
+
+#define NMEA_DAY_MS             (86400000LL)
+#define NMEA_WEEK_MS            (7 * NMEA_DAY_MS)
+#define NMEA_GPS_EPOCH_MS       (315964800000LL) /**< 1980-01-06 00:00:00 UTC as Unix time */
+
+/** Unix time (UTC) leap seconds were inserted before, GPS - UTC is index + 1 since then */
+static const rt_uint32_t nmea_leap_tab[] =
+{
+    362793600,  /* 1981-07-01 */
+    394329600,  /* 1982-07-01 */
+    425865600,  /* 1983-07-01 */
+    489024000,  /* 1985-07-01 */
+    567993600,  /* 1988-01-01 */
+    631152000,  /* 1990-01-01 */
+    662688000,  /* 1991-01-01 */
+    709948800,  /* 1992-07-01 */
+    741484800,  /* 1993-07-01 */
+    773020800,  /* 1994-07-01 */
+    820454400,  /* 1996-01-01 */
+    867715200,  /* 1997-07-01 */
+    915148800,  /* 1999-01-01 */
+    1136073600, /* 2006-01-01 */
+    1230768000, /* 2009-01-01 */
+    1341100800, /* 2012-07-01 */
+    1435708800, /* 2015-07-01 */
+    1483228800, /* 2017-01-01 */
+};
+
+#define NMEA_LEAP_COUNT         ((int)(sizeof(nmea_leap_tab) / sizeof(nmea_leap_tab[0])))
+
+/**
+ * \brief Number of days from 1970-01-01 to date of proleptic Gregorian calendar.
+ * @param year full year.
+ * @param mon month - [1,12].
+ * @param day day of the month - [1,31].
+ */
+rt_inline rt_int32_t nmea_days_from_civil(rt_int32_t year, int mon, int day)
+{
+    rt_int32_t era, yoe, doy, doe;
+
+    /* year starts at March, so leap day is the last one */
+    year -= (mon <= 2);
+    era = (year >= 0 ? year : year - 399) / 400;
+    yoe = year - era * 400;
+    doy = (153 * (mon > 2 ? mon - 3 : mon + 9) + 2) / 5 + day - 1;
+    doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+
+    return era * 146097 + doe - 719468;
+}
+
+/**
+ * \brief Convert UTC date and time to Unix time.
+ * Second 60 (leap second) is counted as the first second of the next minute.
+ * @param utc a pointer of time, date as parsed from RMC (years since 1900, month [0,11]).
+ * @return Milliseconds since 1970-01-01 00:00:00 UTC
+ */
+rt_int64_t nmea_time_unix_ms(const nmea_time_t *utc)
+{
+    rt_int64_t days;
+
+    NMEA_ASSERT(utc);
+
+    days = nmea_days_from_civil(utc->year + 1900, utc->mon + 1, utc->day);
+
+    return days * NMEA_DAY_MS +
+        (((utc->hour * 60 + utc->min) * 60 + utc->sec) * 1000 + utc->hsec * 10);
+}
+
+/**
+ * \brief GPS - UTC offset at the moment.
+ * @param unix_ms Unix time in milliseconds.
+ * @return Leap seconds, 0 before 1981-07-01
+ */
+int nmea_time_leap_seconds(rt_int64_t unix_ms)
+{
+    rt_int64_t sec = unix_ms / 1000;
+    int idx;
+
+    /* fixes are almost always after the last leap second */
+    for (idx = NMEA_LEAP_COUNT; idx > 0 && sec < (rt_int64_t)nmea_leap_tab[idx - 1]; --idx)
+        ;
+
+    return idx;
+}
+
+/**
+ * \brief Convert UTC date and time to GPS time.
+ * @param utc a pointer of time with date.
+ * @param leap_sec GPS - UTC offset in seconds (e.g. from receiver), or
+ * NMEA_LEAP_SECONDS_AUTO - take it from built-in table.
+ * @return Milliseconds since 1980-01-06 00:00:00 GPS time
+ */
+rt_int64_t nmea_time_gps_ms(const nmea_time_t *utc, int leap_sec)
+{
+    rt_int64_t unix_ms = nmea_time_unix_ms(utc);
+
+    /* during inserted second 23:59:60 the old offset is still in effect */
+    if (NMEA_LEAP_SECONDS_AUTO == leap_sec)
+        leap_sec = nmea_time_leap_seconds(60 == utc->sec ? unix_ms - 1000 : unix_ms);
+
+    return unix_ms - NMEA_GPS_EPOCH_MS + (rt_int64_t)leap_sec * 1000;
+}
+
+/**
+ * \brief Convert UTC date and time to GPS week and time of week.
+ * @param utc a pointer of time with date.
+ * @param leap_sec GPS - UTC offset in seconds or NMEA_LEAP_SECONDS_AUTO.
+ * @param tow_ms a pointer for return time of week in milliseconds, may be RT_NULL.
+ * @return Full GPS week number (not rolled over at 1024) or -1 - time is before GPS epoch
+ */
+int nmea_time_gps_week(const nmea_time_t *utc, int leap_sec, rt_int32_t *tow_ms)
+{
+    rt_int64_t gps_ms = nmea_time_gps_ms(utc, leap_sec);
+
+    if (gps_ms < 0)
+        return -1;
+
+    if (tow_ms)
+        *tow_ms = (rt_int32_t)(gps_ms % NMEA_WEEK_MS);
+
+    return (int)(gps_ms / NMEA_WEEK_MS);
+}
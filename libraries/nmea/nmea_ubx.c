@@ -0,0 +1,286 @@
+#include <nmea_parse.h>
+
+/*
+ * Decoders of UBX binary messages which parser takes out of mixed
+ * NMEA/UBX stream. Payload is little endian and not aligned, it is read
+ * byte by byte.
+ */
+
+#define NMEA_UBX_SAT_HEAD       (8)  /**< Header size of NAV-SAT payload */
+#define NMEA_UBX_SAT_BLOCK      (12) /**< Size of satellite block of NAV-SAT */
+
+#define NMEA_UBX_GNSS_SBAS      (1)
+#define NMEA_UBX_GNSS_GLONASS   (6)
+
+rt_inline rt_uint16_t nmea_ubx_u2(const rt_uint8_t *ptr)
+{
+    return (rt_uint16_t)(ptr[0] | (ptr[1] << 8));
+}
+
+rt_inline rt_uint32_t nmea_ubx_u4(const rt_uint8_t *ptr)
+{
+    return (rt_uint32_t)ptr[0] | ((rt_uint32_t)ptr[1] << 8) |
+        ((rt_uint32_t)ptr[2] << 16) | ((rt_uint32_t)ptr[3] << 24);
+}
+
+#define nmea_ubx_i2(ptr)        ((rt_int16_t)nmea_ubx_u2(ptr))
+#define nmea_ubx_i4(ptr)        ((rt_int32_t)nmea_ubx_u4(ptr))
+
+/**
+ * \brief 8-bit Fletcher checksum of UBX frame.
+ * @param buff a pointer of frame from class byte to the end of payload.
+ * @param buff_sz size of class, ID, length and payload.
+ * @return Checksum, CK_A in low byte and CK_B in high byte
+ */
+rt_uint16_t nmea_ubx_checksum(const rt_uint8_t *buff, int buff_sz)
+{
+    rt_uint8_t ck_a = 0, ck_b = 0;
+
+    NMEA_ASSERT(buff);
+
+    for (; buff_sz > 0; --buff_sz, ++buff)
+    {
+        ck_a += *buff;
+        ck_b += ck_a;
+    }
+
+    return (rt_uint16_t)(ck_a | (ck_b << 8));
+}
+
+/**
+ * \brief Decode NAV-PVT message.
+ * @param payload a pointer of frame payload.
+ * @param payload_sz payload size.
+ * @param pvt a pointer of message which will filled by function.
+ * @return 1 (true) - if decoded successfully or 0 (false) - if payload is too short.
+ */
+int nmea_ubx_decode_pvt(const rt_uint8_t *payload, int payload_sz, nmea_ubx_pvt_t *pvt)
+{
+    NMEA_ASSERT(payload && pvt);
+
+    if (payload_sz < NMEA_UBX_NAV_PVT_SIZE)
+        return 0;
+
+    pvt->itow = nmea_ubx_u4(payload);
+    pvt->year = nmea_ubx_u2(payload + 4);
+    pvt->month = payload[6];
+    pvt->day = payload[7];
+    pvt->hour = payload[8];
+    pvt->min = payload[9];
+    pvt->sec = payload[10];
+    pvt->valid = payload[11];
+    pvt->t_acc = nmea_ubx_u4(payload + 12);
+    pvt->nano = nmea_ubx_i4(payload + 16);
+    pvt->fix_type = payload[20];
+    pvt->flags = payload[21];
+    pvt->num_sv = payload[23];
+    pvt->lon = nmea_ubx_i4(payload + 24);
+    pvt->lat = nmea_ubx_i4(payload + 28);
+    pvt->height = nmea_ubx_i4(payload + 32);
+    pvt->h_msl = nmea_ubx_i4(payload + 36);
+    pvt->h_acc = nmea_ubx_u4(payload + 40);
+    pvt->v_acc = nmea_ubx_u4(payload + 44);
+    pvt->vel_n = nmea_ubx_i4(payload + 48);
+    pvt->vel_e = nmea_ubx_i4(payload + 52);
+    pvt->vel_d = nmea_ubx_i4(payload + 56);
+    pvt->g_speed = nmea_ubx_i4(payload + 60);
+    pvt->head_mot = nmea_ubx_i4(payload + 64);
+    pvt->s_acc = nmea_ubx_u4(payload + 68);
+    pvt->head_acc = nmea_ubx_u4(payload + 72);
+    pvt->p_dop = nmea_ubx_u2(payload + 76);
+
+    return 1;
+}
+
+/**
+ * \brief Decode header of NAV-SAT message.
+ * @param payload a pointer of frame payload.
+ * @param payload_sz payload size.
+ * @param sat a pointer of message header which will filled by function.
+ * @return 1 (true) - if decoded successfully or 0 (false) - if payload
+ * is shorter than its satellites.
+ */
+int nmea_ubx_decode_sat(const rt_uint8_t *payload, int payload_sz, nmea_ubx_sat_t *sat)
+{
+    NMEA_ASSERT(payload && sat);
+
+    if (payload_sz < NMEA_UBX_SAT_HEAD ||
+        payload_sz < NMEA_UBX_SAT_HEAD + payload[5] * NMEA_UBX_SAT_BLOCK)
+        return 0;
+
+    sat->itow = nmea_ubx_u4(payload);
+    sat->version = payload[4];
+    sat->num_svs = payload[5];
+
+    return 1;
+}
+
+/**
+ * \brief Decode satellite of NAV-SAT message.
+ * @param idx satellite index, 0..num_svs-1.
+ * @param sv a pointer of satellite which will filled by function.
+ * @return 1 (true) - if decoded successfully or 0 (false) - if there is no such satellite.
+ */
+int nmea_ubx_decode_sv(const rt_uint8_t *payload, int payload_sz, int idx, nmea_ubx_sv_t *sv)
+{
+    const rt_uint8_t *block;
+
+    NMEA_ASSERT(payload && sv);
+
+    if (idx < 0 || payload_sz < NMEA_UBX_SAT_HEAD + (idx + 1) * NMEA_UBX_SAT_BLOCK)
+        return 0;
+
+    block = payload + NMEA_UBX_SAT_HEAD + idx * NMEA_UBX_SAT_BLOCK;
+    sv->gnss_id = block[0];
+    sv->sv_id = block[1];
+    sv->cno = block[2];
+    sv->elev = (rt_int8_t)block[3];
+    sv->azim = nmea_ubx_i2(block + 4);
+    sv->pr_res = nmea_ubx_i2(block + 6);
+    sv->flags = nmea_ubx_u4(block + 8);
+
+    return 1;
+}
+
+#ifndef NMEA_USING_FIXED_POINT
+/**
+ * \brief Convert 1e-7 degrees to NDEG ([degree][min].[sec/60]).
+ */
+static double nmea_ubx_ndeg(rt_int32_t val)
+{
+    double deg = (val < 0 ? -(double)val : (double)val) / 1e7;
+    int ideg = (int)deg;
+    double ndeg = ideg * 100 + (deg - ideg) * 60;
+
+    return (val < 0) ? -ndeg : ndeg;
+}
+#endif
+
+/**
+ * \brief Fill nmea_info_t structure by NAV-PVT message.
+ * Position, time, speed and track of one frame replace the ones of GGA,
+ * RMC and VTG; packet mask (smask) is not changed.
+ * @param pvt a pointer of decoded message.
+ * @param info a pointer of summary information structure.
+ */
+void nmea_ubx_pvt_info(const nmea_ubx_pvt_t *pvt, nmea_info_t *info)
+{
+    int carr_soln;
+
+    NMEA_ASSERT(pvt && info);
+
+    if (pvt->valid & 0x01)
+    {
+        info->utc.year = pvt->year - 1900;
+        info->utc.mon = pvt->month - 1;
+        info->utc.day = pvt->day;
+    }
+    if (pvt->valid & 0x02)
+    {
+        info->utc.hour = pvt->hour;
+        info->utc.min = pvt->min;
+        info->utc.sec = pvt->sec;
+        /* negative fraction belongs to the rounded up second, it is cut */
+        info->utc.hsec = (pvt->nano > 0) ? pvt->nano / 10000000 : 0;
+    }
+
+    /* quality indicator of GGA */
+    carr_soln = pvt->flags >> 6;
+    if (!(pvt->flags & 0x01) || 0 == pvt->fix_type || 5 == pvt->fix_type)
+        info->sig = 0;
+    else if (1 == pvt->fix_type)
+        info->sig = 6;
+    else if (2 == carr_soln)
+        info->sig = 4;
+    else if (1 == carr_soln)
+        info->sig = 5;
+    else
+        info->sig = (pvt->flags & 0x02) ? 2 : 1;
+
+    if (!info->sig)
+        info->fix = NMEA_FIX_BAD;
+    else
+        info->fix = (2 == pvt->fix_type) ? NMEA_FIX_2D : NMEA_FIX_3D;
+
+#ifdef NMEA_USING_FIXED_POINT
+    info->lat = pvt->lat;
+    info->lon = pvt->lon;
+    info->elv = pvt->h_msl;
+    info->PDOP = pvt->p_dop;
+    info->speed = (nmea_centi_t)(((rt_int64_t)pvt->g_speed * 36 + 50) / 100);
+    info->direction = (pvt->head_mot + 500) / 1000;
+#else
+    info->lat = nmea_ubx_ndeg(pvt->lat);
+    info->lon = nmea_ubx_ndeg(pvt->lon);
+    info->elv = pvt->h_msl / 1000.0;
+    info->PDOP = pvt->p_dop / 100.0;
+    info->speed = pvt->g_speed * 0.0036;
+    info->direction = pvt->head_mot / 1e5;
+#endif
+    info->satinfo.inuse = pvt->num_sv;
+}
+
+/**
+ * \brief Fill satellites of nmea_info_t structure by NAV-SAT message.
+ * Satellite IDs follow NMEA numbering (GLONASS 65..96, SBAS 33..64).
+ * @param payload a pointer of frame payload.
+ * @param payload_sz payload size.
+ * @param info a pointer of summary information structure.
+ */
+void nmea_ubx_sat_info(const rt_uint8_t *payload, int payload_sz, nmea_info_t *info)
+{
+    nmea_ubx_sat_t sat;
+    nmea_ubx_sv_t sv;
+    nmea_satellite_t *dst;
+    int isv, nsat = 0, nuse = 0;
+
+    NMEA_ASSERT(payload && info);
+
+    if (!nmea_ubx_decode_sat(payload, payload_sz, &sat))
+        return;
+
+    for (isv = 0; isv < sat.num_svs && nsat < NMEA_MAXSAT; ++isv)
+    {
+        nmea_ubx_decode_sv(payload, payload_sz, isv, &sv);
+
+        dst = &info->satinfo.sat[nsat++];
+        dst->id = sv.sv_id;
+        if (NMEA_UBX_GNSS_GLONASS == sv.gnss_id)
+            dst->id += 64;
+        else if (NMEA_UBX_GNSS_SBAS == sv.gnss_id && sv.sv_id >= 120)
+            dst->id -= 87;
+        dst->in_use = (sv.flags & 0x08) ? 1 : 0;
+        dst->elv = sv.elev;
+        dst->azimuth = sv.azim;
+        dst->sig = sv.cno;
+        nuse += dst->in_use;
+    }
+
+    /* satellites of longer list before are dropped */
+    rt_memset(&info->satinfo.sat[nsat], 0, (NMEA_MAXSAT - nsat) * sizeof(nmea_satellite_t));
+
+    info->satinfo.inview = sat.num_svs;
+    info->satinfo.inuse = nuse;
+}
+
+/**
+ * \brief UBX handler of parser which puts NAV-PVT and NAV-SAT into
+ * summary information, other messages are ignored.
+ * @param user_data a pointer of summary information (nmea_info_t).
+ * @see nmea_parser_set_ubx_handler
+ */
+void nmea_ubx_info_handler(int msg_id, const rt_uint8_t *payload, int payload_sz, void *user_data)
+{
+    nmea_ubx_pvt_t pvt;
+
+    switch (msg_id)
+    {
+    case NMEA_UBX_NAV_PVT:
+        if (nmea_ubx_decode_pvt(payload, payload_sz, &pvt))
+            nmea_ubx_pvt_info(&pvt, (nmea_info_t *)user_data);
+        break;
+    case NMEA_UBX_NAV_SAT:
+        nmea_ubx_sat_info(payload, payload_sz, (nmea_info_t *)user_data);
+        break;
+    };
+}
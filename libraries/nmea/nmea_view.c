@@ -0,0 +1,171 @@
+#include <nmea_parse.h>
+#include <string.h>
+
+/*
+ * Lazy access to fields of sentence: view keeps positions of separators
+ * only, every getter decodes one field in place.
+ */
+
+/**
+ * \brief Index fields of sentence by separators found before (by framing).
+ * @param view a pointer of view.
+ * @param buff a constant character pointer of sentence from '$' to "\r\n", checksum is right.
+ * @param buff_sz sentence size.
+ * @param field_off offsets of ',' separators from '$'.
+ * @param field_count number of separators.
+ * @return 1 - success or 0 - sentence has too many fields
+ */
+int nmea_view_index(nmea_sentence_view_t *view, const char *buff, int buff_sz,
+    const rt_uint16_t *field_off, int field_count)
+{
+    NMEA_ASSERT(view && buff && field_off);
+
+    if (field_count > NMEA_MAX_FIELDS || buff_sz < 5)
+        return 0;
+
+    view->buff = buff;
+    view->buff_sz = buff_sz;
+    view->field_count = field_count;
+    if (field_off != view->field_off)
+        rt_memcpy(view->field_off, field_off, field_count * sizeof(rt_uint16_t));
+    /* sentence ends by "*hh\r\n" */
+    view->field_off[field_count] = (rt_uint16_t)(buff_sz - 5);
+    view->ptype = nmea_pack_type(buff + 1, (field_count ? field_off[0] : buff_sz - 5) - 1);
+
+    return 1;
+}
+
+/**
+ * \brief Check sentence and index its fields.
+ * @param view a pointer of view.
+ * @param buff a constant character pointer of sentence, starts at '$'.
+ * @param buff_sz buffer size, may hold more than one sentence.
+ * @return Size of sentence or 0 - no complete sentence, wrong checksum or too many fields
+ */
+int nmea_view_init(nmea_sentence_view_t *view, const char *buff, int buff_sz)
+{
+    const char *pos, *star;
+    int nread, crc, field_count = 0;
+
+    NMEA_ASSERT(view && buff);
+
+    nread = nmea_find_tail(buff, buff_sz, &crc);
+    if (!nread || crc < 0)
+        return 0;
+
+    star = buff + nread - 5;
+    for (pos = buff; (pos = (const char *)memchr(pos, ',', star - pos)) != RT_NULL; ++pos)
+    {
+        if (field_count >= NMEA_MAX_FIELDS)
+            return 0;
+        view->field_off[field_count++] = (rt_uint16_t)(pos - buff);
+    }
+
+    return nmea_view_index(view, buff, nread, view->field_off, field_count) ? nread : 0;
+}
+
+/**
+ * \brief Get raw field of sentence.
+ * @param idx field index, 0 - address field.
+ * @param len a integer pointer for return field size.
+ * @return Pointer of field or RT_NULL if sentence has no such field
+ */
+const char *nmea_view_field(const nmea_sentence_view_t *view, int idx, int *len)
+{
+    int start;
+
+    NMEA_ASSERT(view && len);
+
+    if (idx < 0 || idx > view->field_count)
+    {
+        *len = 0;
+        return RT_NULL;
+    }
+
+    start = idx ? view->field_off[idx - 1] + 1 : 1;
+    *len = view->field_off[idx] - start;
+
+    return view->buff + start;
+}
+
+/**
+ * \brief Decode integer field.
+ * @return Value or 0 if field is empty or absent
+ */
+int nmea_view_get_int(const nmea_sentence_view_t *view, int idx)
+{
+    int len;
+    const char *str = nmea_view_field(view, idx, &len);
+
+    return len ? nmea_atoi(str, len, 10) : 0;
+}
+
+/**
+ * \brief Decode number field.
+ * @return Value or 0 if field is empty or absent
+ */
+double nmea_view_get_double(const nmea_sentence_view_t *view, int idx)
+{
+    int len;
+    const char *str = nmea_view_field(view, idx, &len);
+
+    return len ? nmea_atof(str, len) : 0;
+}
+
+/**
+ * \brief Get the first character of field.
+ * @return Character or 0 if field is empty or absent
+ */
+char nmea_view_get_char(const nmea_sentence_view_t *view, int idx)
+{
+    int len;
+    const char *str = nmea_view_field(view, idx, &len);
+
+    return len ? str[0] : 0;
+}
+
+/**
+ * \brief Decode coordinate field [d]ddmm.mmmm and hemisphere field after it.
+ * Unlike packets, value is negative for 'S' and 'W'.
+ * @param idx index of coordinate field.
+ * @return Coordinate (nmea_coord_t) or 0 if field is empty, absent or broken
+ */
+nmea_coord_t nmea_view_get_latlon(const nmea_sentence_view_t *view, int idx)
+{
+    char hemi = nmea_view_get_char(view, idx + 1);
+    nmea_coord_t val = 0;
+    const char *str;
+    int len;
+
+    str = nmea_view_field(view, idx, &len);
+    if (!len)
+        return 0;
+
+#ifdef NMEA_USING_FIXED_POINT
+    if (nmea_ndeg_atofix(str, len, &val) < 0)
+        return 0;
+#else
+    val = nmea_atof(str, len);
+#endif
+
+    return ('S' == hemi || 'W' == hemi) ? -val : val;
+}
+
+/**
+ * \brief Decode time field hhmmss[.sss].
+ * @param res a pointer for return time, date is not changed.
+ * @return 0 - success or -1 - field is absent or broken
+ */
+int nmea_view_get_time(const nmea_sentence_view_t *view, int idx, nmea_time_t *res)
+{
+    const char *str;
+    int len;
+
+    NMEA_ASSERT(res);
+
+    str = nmea_view_field(view, idx, &len);
+    if (!str)
+        return -1;
+
+    return nmea_field_time(str, len, res);
+}